@@ -0,0 +1,256 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Activation.h
+/// Description  :  Platform independent action cam toggle decisions.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef ACTIVATION_H
+#define ACTIVATION_H
+
+#include <cstdint>
+
+enum EOverride : uint32_t
+{
+	EOverride_None,
+	EOverride_ManualOn,  /* The player turned action cam on themselves. */
+	EOverride_ManualOff, /* The player turned action cam off themselves. */
+	EOverride_Resume     /* The player pressed the key again under EOverrideExpiry_Never, ends on the next step. */
+};
+
+enum EOverrideExpiry
+{
+	EOverrideExpiry_OnConditionChange, /* Once the activation conditions change, e.g. the player stops moving. */
+	EOverrideExpiry_Timeout,           /* After OverrideTimeoutSec. */
+	EOverrideExpiry_Never              /* Until the player presses the key again. */
+};
+
+/* Activation settings, the cursor handling ones are applied by the addon itself. */
+enum EActivationFlags : uint32_t
+{
+	EActivation_ResetToCenter = 1 << 0,
+	EActivation_WhileMoving   = 1 << 1,
+	EActivation_InCombat      = 1 << 2,
+	EActivation_OnMount       = 1 << 3,
+	EActivation_RestoreCursor = 1 << 4,
+	EActivation_ZoomedIn      = 1 << 5,
+	EActivation_COUNT         = 1 << 6 /* Number of flag combinations. */
+};
+
+/* MumbleLink's UI state, decoded once per frame. */
+enum EUiState : uint32_t
+{
+	EUiState_None            = 0,
+	EUiState_MapOpen         = 1 << 0,
+	EUiState_CompassTopRight = 1 << 1,
+	EUiState_CompassRotating = 1 << 2,
+	EUiState_GameUnfocused   = 1 << 3, /* Inverse of Context.IsGameFocused, so every bit reads as "set suspends". */
+	EUiState_Competitive     = 1 << 4,
+	EUiState_TextboxFocused  = 1 << 5,
+	EUiState_InCombat        = 1 << 6
+};
+
+///----------------------------------------------------------------------------------------------------
+/// Activation Namespace
+/// 	Decides when to toggle action cam from plain values, without touching the game, the window or
+/// 	the Nexus API, so it can be driven from recorded or synthetic input.
+///----------------------------------------------------------------------------------------------------
+namespace Activation
+{
+	///----------------------------------------------------------------------------------------------------
+	/// Frame:
+	/// 	Inputs to a single step.
+	///----------------------------------------------------------------------------------------------------
+	struct Frame
+	{
+		bool    CursorControlled; /* Action cam is on, as far as the cursor tells. */
+		bool    ShouldActivate;   /* Activation conditions are met and nothing suspends. */
+		int64_t Now;              /* Monotonic ticks, same unit as Rules::OverrideTimeout. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Conditions:
+	/// 	The parts of a link snapshot the activation settings look at.
+	///----------------------------------------------------------------------------------------------------
+	struct Conditions
+	{
+		bool IsMoving;
+		bool InCombat;
+		bool IsMounted;
+		bool IsZoomedIn;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// ShouldActivate:
+	/// 	Returns whether any condition enabled in Flags is met. Instantiated per combination of
+	/// 	EActivationFlags, so the per-frame path does not branch on the settings.
+	///----------------------------------------------------------------------------------------------------
+	template <uint32_t Flags>
+	inline bool ShouldActivate(const Conditions& aConditions)
+	{
+		bool shouldActivate = false;
+
+		if constexpr ((Flags & EActivation_WhileMoving) != 0)
+		{
+			shouldActivate |= aConditions.IsMoving;
+		}
+		if constexpr ((Flags & EActivation_InCombat) != 0)
+		{
+			shouldActivate |= aConditions.InCombat;
+		}
+		if constexpr ((Flags & EActivation_OnMount) != 0)
+		{
+			shouldActivate |= aConditions.IsMounted;
+		}
+		if constexpr ((Flags & EActivation_ZoomedIn) != 0)
+		{
+			shouldActivate |= aConditions.IsZoomedIn;
+		}
+
+		return shouldActivate;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ShouldActivate:
+	/// 	The same, branching on the settings every call. The baseline the instantiations are tested
+	/// 	and benchmarked against.
+	///----------------------------------------------------------------------------------------------------
+	inline bool ShouldActivate(uint32_t aFlags, const Conditions& aConditions)
+	{
+		return ((aFlags & EActivation_WhileMoving) && aConditions.IsMoving)
+		    || ((aFlags & EActivation_InCombat)    && aConditions.InCombat)
+		    || ((aFlags & EActivation_OnMount)     && aConditions.IsMounted)
+		    || ((aFlags & EActivation_ZoomedIn)    && aConditions.IsZoomedIn);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Rules:
+	/// 	Configuration of a step.
+	///----------------------------------------------------------------------------------------------------
+	struct Rules
+	{
+		int     OverrideExpiry;  /* EOverrideExpiry */
+		int64_t OverrideTimeout; /* Ticks */
+		int64_t ToggleLatency;   /* Ticks the game may take to apply a toggle. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// State:
+	/// 	Carried from step to step.
+	///----------------------------------------------------------------------------------------------------
+	struct State
+	{
+		bool     WasActive;         /* The addon itself turned action cam on. */
+		uint32_t Override;          /* EOverride */
+		bool     OverrideCondition; /* ShouldActivate when the override started. */
+		int64_t  OverrideSince;     /* Frame::Now when the override started. */
+		int64_t  ToggledAt;         /* Frame::Now of the last EStep_Toggle. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// OverrideForPress:
+	/// 	Returns the override a press of the player's action cam key results in. Under
+	/// 	EOverrideExpiry_Never nothing else ends an override, so a press during one hands control back.
+	///----------------------------------------------------------------------------------------------------
+	inline uint32_t OverrideForPress(uint32_t aCurrent, uint32_t aPressed, int aExpiry)
+	{
+		if (aExpiry == EOverrideExpiry_Never && (aCurrent == EOverride_ManualOn || aCurrent == EOverride_ManualOff))
+		{
+			return EOverride_Resume;
+		}
+
+		return aPressed;
+	}
+
+	enum EStep
+	{
+		EStep_None,
+		EStep_Toggle,    /* Toggle action cam now. */
+		EStep_Overridden /* The player is in charge, nothing was evaluated. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Step:
+	/// 	Advances aState by one frame and returns what to do.
+	///----------------------------------------------------------------------------------------------------
+	inline EStep Step(State& aState, const Frame& aFrame, const Rules& aRules)
+	{
+		/* The player is in charge until the override expires. */
+		if (aState.Override != EOverride_None)
+		{
+			bool expired = aState.Override == EOverride_Resume;
+
+			switch (aRules.OverrideExpiry)
+			{
+				case EOverrideExpiry_OnConditionChange:
+				{
+					expired = aFrame.ShouldActivate != aState.OverrideCondition;
+					break;
+				}
+				case EOverrideExpiry_Timeout:
+				{
+					expired = aFrame.Now - aState.OverrideSince > aRules.OverrideTimeout;
+					break;
+				}
+			}
+
+			if (!expired)
+			{
+				return EStep_Overridden;
+			}
+
+			/* Take over whatever state the player left action cam in. */
+			aState.Override  = EOverride_None;
+			aState.WasActive = aFrame.CursorControlled;
+		}
+
+		//  is active                && should be active
+		if (aFrame.CursorControlled && aFrame.ShouldActivate)
+		{
+			/* nop */
+		}
+		//       not active                && should be active
+		else if (!aFrame.CursorControlled && aFrame.ShouldActivate)
+		{
+			if (aState.WasActive) // left by other means, e.g. the action cam key is not configured
+			{
+				/* nop */
+			}
+			else
+			{
+				aState.WasActive = true;
+				aState.ToggledAt = aFrame.Now;
+				return EStep_Toggle;
+			}
+		}
+		//       is active                && should not be active
+		else if (aFrame.CursorControlled && !aFrame.ShouldActivate)
+		{
+			if (aState.WasActive)
+			{
+				aState.WasActive = false;
+				aState.ToggledAt = aFrame.Now;
+				return EStep_Toggle;
+			}
+			else
+			{
+				/* turned on by other means, leave it alone */
+			}
+		}
+		//       not active                && should not be active
+		else if (!aFrame.CursorControlled && !aFrame.ShouldActivate)
+		{
+			/* Left by other means, e.g. while the conditions still held. The addon no longer holds it, or it
+			 * would never turn it on again. Unless the game has yet to apply the addon's own toggle. */
+			if (aState.WasActive && aFrame.Now - aState.ToggledAt > aRules.ToggleLatency)
+			{
+				aState.WasActive = false;
+			}
+		}
+
+		return EStep_None;
+	}
+}
+
+#endif
@@ -10,6 +10,10 @@
 
 #include <windows.h>
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <new>
 #include <filesystem>
 #include <fstream>
 #include <dxgi.h>
@@ -24,6 +28,13 @@ using json = nlohmann::json;
 #include "RTAPI/RTAPI.hpp"
 #include "Version.h"
 #include "Remote.h"
+#include "Core.h"
+#include "GameBinds.h"
+#include "Geometry.h"
+#include "Input.h"
+#include "Trace.h"
+#include "Profiler.h"
+#include "Shared.h"
 #include "Util/src/Strings.h"
 #include "Util/src/Inputs.h"
 
@@ -52,19 +63,44 @@ extern "C" __declspec(dllexport) AddonDefinition* GetAddonDef()
 	return &s_AddonDef;
 }
 
-namespace Config
+static_assert((uint32_t)ERedirectContext_Default == MouseLookHandler::EProfile_Default
+           && (uint32_t)ERedirectContext_Combat  == MouseLookHandler::EProfile_Combat
+           && (uint32_t)ERedirectContext_Mount   == MouseLookHandler::EProfile_Mount, "Shared profiles must match the redirect contexts.");
+
+static_assert(Input::EMessage_KeyDown       == WM_KEYDOWN       && Input::EMessage_KeyUp         == WM_KEYUP
+           && Input::EMessage_SysKeyDown    == WM_SYSKEYDOWN    && Input::EMessage_SysKeyUp      == WM_SYSKEYUP
+           && Input::EMessage_MouseMove     == WM_MOUSEMOVE
+           && Input::EMessage_LButtonDown   == WM_LBUTTONDOWN   && Input::EMessage_LButtonUp     == WM_LBUTTONUP
+           && Input::EMessage_LButtonDblClk == WM_LBUTTONDBLCLK && Input::EMessage_RButtonDown   == WM_RBUTTONDOWN
+           && Input::EMessage_RButtonUp     == WM_RBUTTONUP     && Input::EMessage_RButtonDblClk == WM_RBUTTONDBLCLK
+           && Input::EMouseKey_LButton      == MK_LBUTTON       && Input::EMouseKey_RButton      == MK_RBUTTON
+           && Input::EMouseKey_Shift        == MK_SHIFT         && Input::EMouseKey_Control      == MK_CONTROL
+           && Input::EMessage_Move          == WM_MOVE          && Input::EMessage_Size          == WM_SIZE
+           && Input::EMessage_SetCursor     == WM_SETCURSOR     && Input::EMessage_DisplayChange == WM_DISPLAYCHANGE
+           && Input::EMessage_DpiChanged    == WM_DPICHANGED, "Input messages must match the window messages.");
+
+enum EKeyCapture
 {
-	bool       ResetToCenter      = false;
-	bool       EnableWhileMoving  = true;
-	bool       EnableInCombat     = false;
-	bool       EnableOnMount      = false;
-
-	bool       RedirectLMB        = false;
-	EGameBinds RedirectLMB_Target = (EGameBinds)0;
+	EKeyCapture_None,
+	EKeyCapture_Remap,
+	EKeyCapture_UiKey,
+	EKeyCapture_ActionCamKey,
+	EKeyCapture_ActionCamDisableKey
+};
+
+enum EDataField
+{
+	EDataField_InCombat,
+	EDataField_MountIndex,
+	EDataField_COUNT
+};
 
-	bool       RedirectRMB        = false;
-	EGameBinds RedirectRMB_Target = (EGameBinds)0;
-}
+enum EDataSource
+{
+	EDataSource_MumbleLink,
+	EDataSource_RTAPI,
+	EDataSource_COUNT
+};
 
 namespace Addon
 {
@@ -73,9 +109,383 @@ namespace Addon
 
 	static NexusLinkData*       s_NexusLink    = nullptr;
 	static Mumble::Data*        s_MumbleLink   = nullptr;
+	/* Null until the RealTime API addon shares its data. */
+	static std::atomic<RTAPI::RealTimeData*> s_RTAPI = nullptr;
+	/* Published for other addons, written by PreRender only. */
+	static MouseLookHandler::SharedState*    s_SharedState = nullptr;
+	/* Used if the DataLink could not be shared, nobody else sees it then. */
+	static MouseLookHandler::SharedState     s_LocalSharedState;
+	/* Written by other addons, may be shared before we load, so never reinitialized. */
+	static MouseLookHandler::InhibitChannel* s_InhibitChannel = nullptr;
+	/* Used if the DataLink could not be shared, nobody else can inhibit then. */
+	static MouseLookHandler::InhibitChannel  s_LocalInhibitChannel;
 
 	static HWND                 s_WindowHandle = nullptr;
 
+	/* The user preferences, applied to s_Handler under s_Mutex. */
+	static Core::Config         s_Config;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Now:
+	/// 	Returns the performance counter.
+	///----------------------------------------------------------------------------------------------------
+	static int64_t Now()
+	{
+		LARGE_INTEGER now{};
+		QueryPerformanceCounter(&now);
+		return now.QuadPart;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// GameOutput:
+	/// 	Passes the decisions of s_Handler on to the game through Nexus.
+	///----------------------------------------------------------------------------------------------------
+	class GameOutput : public Core::GameProvider
+	{
+	public:
+		void Press(Input::Bind aBind) override
+		{
+			s_APIDefs->GameBinds.Press((EGameBinds)aBind);
+		}
+
+		void Release(Input::Bind aBind) override
+		{
+			s_APIDefs->GameBinds.Release((EGameBinds)aBind);
+		}
+
+		void ButtonUp(uint32_t aMsg, uint64_t aWParam, int64_t aLParam) override
+		{
+			s_APIDefs->WndProc.SendToGameOnly(s_WindowHandle, aMsg, (WPARAM)aWParam, (LPARAM)aLParam);
+		}
+
+		void ToggleActionCam(bool aImmediate) override
+		{
+			if (aImmediate)
+			{
+				s_APIDefs->GameBinds.Press(EGameBinds_CameraActionMode);
+				s_APIDefs->GameBinds.Release(EGameBinds_CameraActionMode);
+			}
+			else
+			{
+				s_APIDefs->GameBinds.InvokeAsync(EGameBinds_CameraActionMode, 0);
+			}
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// SystemCursor:
+	/// 	The Win32 cursor.
+	///----------------------------------------------------------------------------------------------------
+	class SystemCursor : public Core::CursorProvider
+	{
+	public:
+		bool IsHidden() override
+		{
+			return Inputs::IsCursorHidden();
+		}
+
+		void GetPosition(int32_t& aX, int32_t& aY) override
+		{
+			POINT pos{};
+			GetCursorPos(&pos);
+			aX = pos.x;
+			aY = pos.y;
+		}
+
+		void SetPosition(int32_t aX, int32_t aY) override
+		{
+			SetCursorPos(aX, aY);
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// GameWindow:
+	/// 	Queries the client area of the game window from the window manager.
+	///----------------------------------------------------------------------------------------------------
+	class GameWindow : public Core::WindowProvider
+	{
+	public:
+		Geometry::ClientRect QueryClientRect() override
+		{
+			RECT  rect{};
+			POINT origin{};
+			GetClientRect(s_WindowHandle, &rect);
+			ClientToScreen(s_WindowHandle, &origin);
+
+			return Geometry::ClientRect{ origin.x, origin.y, rect.right - rect.left, rect.bottom - rect.top };
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// PerformanceCounter:
+	/// 	The clock s_Handler measures with.
+	///----------------------------------------------------------------------------------------------------
+	class PerformanceCounter : public Core::ClockProvider
+	{
+	public:
+		int64_t Now() override
+		{
+			return Addon::Now();
+		}
+
+		int64_t TicksPerSecond() override
+		{
+			LARGE_INTEGER frequency{};
+			QueryPerformanceFrequency(&frequency);
+			return frequency.QuadPart;
+		}
+	};
+
+	/* Options key capture: -1 idle, -2 waiting for a key, otherwise the captured virtual-key code. */
+	static std::atomic<int32_t>           s_KeyCapture = -1;
+	/* Which options editor started the capture. Render thread only. */
+	static int                            s_KeyCaptureOwner = EKeyCapture_None;
+	/* Frames rendered and the last one the options were rendered on, a capture is cancelled once the
+	 * options are closed. Render thread only. */
+	static uint64_t                       s_Frame           = 0;
+	static uint64_t                       s_OptionsFrame    = 0;
+
+	/* Frames each field was served by each source. */
+	static std::atomic<uint64_t> s_SourceFrames[EDataField_COUNT][EDataSource_COUNT] = {};
+	/* Changes RTAPI reported before MumbleLink caught up, and the summed lead in performance counter ticks. */
+	static std::atomic<uint64_t> s_RtapiLeads[EDataField_COUNT]                      = {};
+	static std::atomic<uint64_t> s_RtapiLeadTicks[EDataField_COUNT]                  = {};
+
+	struct FieldLead
+	{
+		uint32_t RTAPI;
+		uint32_t MumbleLink;
+		int64_t  Since;      /* When RTAPI last changed, 0 once MumbleLink caught up. */
+	};
+
+	/* Last value per source, render thread only. */
+	static FieldLead s_FieldLead[EDataField_COUNT] = {};
+
+	/* Set by the addon load/unload events, the RTAPI DataLink is looked up again on the next frame. */
+	static std::atomic<bool> s_RtapiStale          = true;
+	/* Frames since the RTAPI DataLink was last looked up. RTAPI may share it after its load event fired,
+	 * so it is looked up again every RTAPI_RETRY_FRAMES while missing. Render thread only. */
+	static uint32_t          s_RtapiRetry          = 0;
+	static constexpr uint32_t RTAPI_RETRY_FRAMES   = 600;
+	/* Set by the identity event, the leads are reset on the next frame. */
+	static std::atomic<bool> s_IdentityStale       = false;
+	/* Set whenever game binds may have changed, the bound cache is dropped on the next lookup. */
+	static std::atomic<bool> s_BoundStale          = true;
+
+	/* Cached values dropped by Nexus events, and the lookups served from cache in between. */
+	static std::atomic<uint64_t> s_CacheInvalidations = 0;
+	static std::atomic<uint64_t> s_CacheHits          = 0;
+
+	///----------------------------------------------------------------------------------------------------
+	/// TrackLead:
+	/// 	Measures how far RTAPI is ahead of MumbleLink for a field.
+	///----------------------------------------------------------------------------------------------------
+	static void TrackLead(EDataField aField, uint32_t aRTAPI, uint32_t aMumbleLink, int64_t aNow)
+	{
+		FieldLead& lead = s_FieldLead[aField];
+
+		if (aRTAPI != lead.RTAPI)
+		{
+			lead.RTAPI = aRTAPI;
+			lead.Since = aNow;
+		}
+
+		if (aMumbleLink != lead.MumbleLink)
+		{
+			lead.MumbleLink = aMumbleLink;
+
+			if (aMumbleLink == aRTAPI && lead.Since != 0)
+			{
+				s_RtapiLeads[aField].fetch_add(1, std::memory_order_relaxed);
+				s_RtapiLeadTicks[aField].fetch_add(aNow - lead.Since, std::memory_order_relaxed);
+				lead.Since = 0;
+			}
+		}
+	}
+
+	/* RTAPI has no frame counter. Its camera updates every game frame, so it must move whenever MumbleLink's
+	 * camera does. Consecutive reads where only MumbleLink's camera moved, and the positions last read.
+	 * Render thread only. */
+	static uint32_t          s_RtapiFrozenReads    = 0;
+	static float             s_RtapiCamera[3]      = {};
+	static Mumble::Vector3   s_MumbleCamera        = {};
+	static constexpr uint32_t RTAPI_FROZEN_READS   = 30;
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsRtapiLive:
+	/// 	Returns false once RTAPI stopped following MumbleLink, e.g. it is frozen or detached from the game.
+	///----------------------------------------------------------------------------------------------------
+	static bool IsRtapiLive(const RTAPI::RealTimeData* aRTAPI)
+	{
+		const float*           rtapi  = aRTAPI->CameraPosition;
+		const Mumble::Vector3& mumble = s_MumbleLink->CameraPosition;
+
+		bool rtapiMoved  = rtapi[0] != s_RtapiCamera[0] || rtapi[1] != s_RtapiCamera[1] || rtapi[2] != s_RtapiCamera[2];
+		bool mumbleMoved = mumble.X != s_MumbleCamera.X || mumble.Y != s_MumbleCamera.Y || mumble.Z != s_MumbleCamera.Z;
+
+		if (rtapiMoved)
+		{
+			s_RtapiFrozenReads = 0;
+		}
+		else if (mumbleMoved && s_RtapiFrozenReads < RTAPI_FROZEN_READS)
+		{
+			s_RtapiFrozenReads++;
+		}
+
+		std::copy(rtapi, rtapi + 3, s_RtapiCamera);
+		s_MumbleCamera = mumble;
+
+		return s_RtapiFrozenReads < RTAPI_FROZEN_READS;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// AcquireRTAPI:
+	/// 	Returns the RTAPI data if it is shared and live, looking it up again after an addon was loaded
+	/// 	or unloaded, and every now and then while it is missing.
+	///----------------------------------------------------------------------------------------------------
+	static const RTAPI::RealTimeData* AcquireRTAPI()
+	{
+		RTAPI::RealTimeData* rtapi = s_RTAPI.load(std::memory_order_acquire);
+
+		bool stale = s_RtapiStale.load(std::memory_order_relaxed) && s_RtapiStale.exchange(false, std::memory_order_acq_rel);
+		if (!rtapi && ++s_RtapiRetry >= RTAPI_RETRY_FRAMES)
+		{
+			stale = true;
+		}
+
+		if (stale)
+		{
+			s_RtapiRetry = 0;
+			rtapi = (RTAPI::RealTimeData*)s_APIDefs->DataLink.Get(DL_RTAPI);
+			s_RTAPI.store(rtapi, std::memory_order_release);
+		}
+		else
+		{
+			s_CacheHits.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (!rtapi)
+		{
+			return nullptr;
+		}
+
+		/* The game build is only known once RTAPI is attached to the game, it is only updating while its
+		 * camera follows MumbleLink. */
+		return rtapi->GameBuild != 0 && IsRtapiLive(rtapi) ? rtapi : nullptr;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// GameLink:
+	/// 	Reads the Nexus and Mumble links, merged with RTAPI where it is live, and decodes the UI state
+	/// 	bitfield.
+	///----------------------------------------------------------------------------------------------------
+	class GameLink : public Core::LinkProvider
+	{
+	public:
+		void Read(Core::LinkData& aData) override
+		{
+			const Mumble::Context& ctx = s_MumbleLink->Context;
+
+			/* New character or map, the values last seen no longer apply. */
+			if (s_IdentityStale.load(std::memory_order_relaxed) && s_IdentityStale.exchange(false, std::memory_order_acq_rel))
+			{
+				std::fill(std::begin(s_FieldLead), std::end(s_FieldLead), FieldLead{});
+			}
+
+			aData.IsGameplay     = s_NexusLink->IsGameplay;
+			aData.IsMoving       = s_NexusLink->IsMoving;
+			aData.IsCameraMoving = s_NexusLink->IsCameraMoving;
+			aData.MountIndex     = (uint32_t)ctx.MountIndex;
+			aData.UiState        = (ctx.IsMapOpen         ? EUiState_MapOpen         : EUiState_None)
+			                     | (ctx.IsCompassTopRight ? EUiState_CompassTopRight : EUiState_None)
+			                     | (ctx.IsCompassRotating ? EUiState_CompassRotating : EUiState_None)
+			                     | (ctx.IsGameFocused     ? EUiState_None            : EUiState_GameUnfocused)
+			                     | (ctx.IsCompetitive     ? EUiState_Competitive     : EUiState_None)
+			                     | (ctx.IsTextboxFocused  ? EUiState_TextboxFocused  : EUiState_None)
+			                     | (ctx.IsInCombat        ? EUiState_InCombat        : EUiState_None);
+
+			/* RTAPI updates every game frame, MumbleLink only with the game's UI tick. */
+			if (const RTAPI::RealTimeData* rtapi = AcquireRTAPI())
+			{
+				int64_t now = Now();
+
+				/* No character state while e.g. loading, keep MumbleLink for combat then. */
+				uint32_t characterState = rtapi->CharacterState;
+				if (characterState & (RTAPI::CS_IsAlive | RTAPI::CS_IsDowned))
+				{
+					bool inCombat = (characterState & RTAPI::CS_IsInCombat) != 0;
+					TrackLead(EDataField_InCombat, inCombat, ctx.IsInCombat, now);
+
+					aData.UiState = (aData.UiState & ~EUiState_InCombat) | (inCombat ? EUiState_InCombat : EUiState_None);
+					s_SourceFrames[EDataField_InCombat][EDataSource_RTAPI].fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+				{
+					s_SourceFrames[EDataField_InCombat][EDataSource_MumbleLink].fetch_add(1, std::memory_order_relaxed);
+				}
+
+				uint32_t mountIndex = rtapi->MountIndex;
+				TrackLead(EDataField_MountIndex, mountIndex, (uint32_t)ctx.MountIndex, now);
+
+				aData.MountIndex = mountIndex;
+				s_SourceFrames[EDataField_MountIndex][EDataSource_RTAPI].fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				s_SourceFrames[EDataField_InCombat][EDataSource_MumbleLink].fetch_add(1, std::memory_order_relaxed);
+				s_SourceFrames[EDataField_MountIndex][EDataSource_MumbleLink].fetch_add(1, std::memory_order_relaxed);
+			}
+
+			float dx = s_MumbleLink->CameraPosition.X - s_MumbleLink->AvatarPosition.X;
+			float dy = s_MumbleLink->CameraPosition.Y - s_MumbleLink->AvatarPosition.Y;
+			float dz = s_MumbleLink->CameraPosition.Z - s_MumbleLink->AvatarPosition.Z;
+			aData.CameraDistanceSq = dx * dx + dy * dy + dz * dz;
+		}
+
+		bool IsCameraMoving() override
+		{
+			return s_NexusLink->IsCameraMoving;
+		}
+	};
+
+	static GameOutput         s_GameOutput;
+	static SystemCursor       s_SystemCursor;
+	static GameWindow         s_GameWindow;
+	static GameLink           s_GameLink;
+	static PerformanceCounter s_PerformanceCounter;
+
+	/* What PreRender and WndProc decide. Settings are applied under s_Mutex. */
+	static Core::Handler      s_Handler(s_GameOutput, s_SystemCursor, s_GameWindow, s_GameLink, s_PerformanceCounter);
+
+	///----------------------------------------------------------------------------------------------------
+	/// KeyCapture:
+	/// 	Hands a key press to the options if they are waiting for one. Returns true if the key was consumed.
+	///----------------------------------------------------------------------------------------------------
+	static bool KeyCapture(WPARAM wParam)
+	{
+		int32_t expected = -2;
+
+		return s_KeyCapture.load(std::memory_order_relaxed) == expected &&
+			s_KeyCapture.compare_exchange_strong(expected, (int32_t)(wParam & 0xFF));
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// KeyName:
+	/// 	Returns the display name of a virtual-key code. Valid until the next call, options only.
+	///----------------------------------------------------------------------------------------------------
+	static const char* KeyName(uint32_t aVirtualKey)
+	{
+		static char s_Name[64];
+
+		LONG scanCode = MapVirtualKeyA(aVirtualKey, MAPVK_VK_TO_VSC) << 16;
+		if (GetKeyNameTextA(scanCode, s_Name, sizeof(s_Name)) <= 0)
+		{
+			snprintf(s_Name, sizeof(s_Name), "VK 0x%02X", aVirtualKey);
+		}
+
+		return s_Name;
+	}
+
 	void Load(AddonAPI* aApi)
 	{
 		s_APIDefs = aApi;
@@ -85,176 +495,195 @@ namespace Addon
 		s_NexusLink  = (NexusLinkData*)      s_APIDefs->DataLink.Get("DL_NEXUS_LINK");
 		s_MumbleLink = (Mumble::Data*)       s_APIDefs->DataLink.Get("DL_MUMBLE_LINK");
 
-		s_APIDefs->Renderer.Register(ERenderType_PreRender, PreRender);
-		s_APIDefs->Renderer.Register(ERenderType_OptionsRender, RenderOptions);
-
-		s_APIDefs->WndProc.Register(WndProc);
+		void* sharedState = s_APIDefs->DataLink.Share(DL_MLH_STATE, sizeof(MouseLookHandler::SharedState));
+		if (!sharedState)
+		{
+			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, "Could not share " DL_MLH_STATE ", other addons will not see the action cam state.");
+			sharedState = &s_LocalSharedState;
+		}
+		s_SharedState = new (sharedState) MouseLookHandler::SharedState{};
+		s_SharedState->Version.store(MLH_STATE_VERSION, std::memory_order_release);
+		s_InhibitChannel = (MouseLookHandler::InhibitChannel*)s_APIDefs->DataLink.Share(DL_MLH_INHIBIT, sizeof(MouseLookHandler::InhibitChannel));
+		if (!s_InhibitChannel)
+		{
+			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, "Could not share " DL_MLH_INHIBIT ", other addons cannot inhibit action cam.");
+			s_InhibitChannel = &s_LocalInhibitChannel;
+		}
 
 		IDXGISwapChain* swapchain = (IDXGISwapChain*)s_APIDefs->SwapChain;
 		DXGI_SWAP_CHAIN_DESC desc{};
 		swapchain->GetDesc(&desc);
 		s_WindowHandle = desc.OutputWindow;
 
+		s_Handler.Start(s_SharedState, s_InhibitChannel);
+
+		/* Everything the callbacks read must be in place before the first one is registered. */
 		LoadSettings();
+
+		s_APIDefs->Renderer.Register(ERenderType_PreRender, PreRender);
+		s_APIDefs->Renderer.Register(ERenderType_OptionsRender, RenderOptions);
+
+		s_APIDefs->WndProc.Register(WndProc);
+
+		s_APIDefs->InputBinds.RegisterWithString(KB_HOLD_SUSPEND, ProcessKeybind, "(null)");
+
+		s_APIDefs->Events.Subscribe("EV_WINDOW_RESIZED", OnWindowResized);
+		s_APIDefs->Events.Subscribe("EV_MUMBLE_IDENTITY_UPDATED", OnIdentityUpdated);
+		s_APIDefs->Events.Subscribe("EV_ADDON_LOADED", OnAddonsChanged);
+		s_APIDefs->Events.Subscribe("EV_ADDON_UNLOADED", OnAddonsChanged);
 	}
 
 	void Unload()
 	{
+		s_APIDefs->Events.Unsubscribe("EV_ADDON_UNLOADED", OnAddonsChanged);
+		s_APIDefs->Events.Unsubscribe("EV_ADDON_LOADED", OnAddonsChanged);
+		s_APIDefs->Events.Unsubscribe("EV_MUMBLE_IDENTITY_UPDATED", OnIdentityUpdated);
+		s_APIDefs->Events.Unsubscribe("EV_WINDOW_RESIZED", OnWindowResized);
+
+		s_APIDefs->InputBinds.Deregister(KB_HOLD_SUSPEND);
+
 		s_APIDefs->WndProc.Deregister(WndProc);
 
 		s_APIDefs->Renderer.Deregister(PreRender);
 		s_APIDefs->Renderer.Deregister(RenderOptions);
+
+		/* No more messages or frames. */
+		s_Handler.Stop();
+		s_SharedState = nullptr;
 	}
 
 	UINT WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 	{
-		//                      ui is ticking           && cursor not visible
-		bool cursorControlled = s_NexusLink->IsGameplay && Inputs::IsCursorHidden();
+		Profiler::Scope profile(Profiler::EEntry_WndProc);
 
-		if (!cursorControlled)
-		{
-			return 1;
-		}
+		Input::Message message{ uMsg, (uint64_t)wParam, (int64_t)lParam };
 
-		if (Config::RedirectLMB)
+		switch (uMsg)
 		{
-			switch (uMsg)
+			case WM_LBUTTONDBLCLK:
+			case WM_LBUTTONDOWN:
+			case WM_RBUTTONDBLCLK:
+			case WM_RBUTTONDOWN:
 			{
-				case WM_LBUTTONDBLCLK:
-				case WM_LBUTTONDOWN:
-				{
-					s_APIDefs->GameBinds.Press(Config::RedirectLMB_Target);
-					return 0;
-				}
-				case WM_LBUTTONUP:
+				message.Alt = (GetKeyState(VK_MENU) & 0x8000) != 0;
+				break;
+			}
+			case WM_MOVE:
+			case WM_SIZE:
+			case WM_DPICHANGED:
+			case WM_DISPLAYCHANGE:
+			{
+				/* Only the game window's client area is tracked. */
+				if (hWnd != s_WindowHandle)
 				{
-					s_APIDefs->GameBinds.Release(Config::RedirectLMB_Target);
-
-					/* Releases should always be passed on. */
 					return 1;
 				}
+				break;
 			}
-		}
-
-		if (Config::RedirectRMB)
-		{
-			switch (uMsg)
+			case WM_KEYDOWN:
+			case WM_SYSKEYDOWN:
 			{
-				case WM_RBUTTONDBLCLK:
-				case WM_RBUTTONDOWN:
+				if (KeyCapture(wParam))
 				{
-					s_APIDefs->GameBinds.Press(Config::RedirectRMB_Target);
 					return 0;
 				}
-				case WM_RBUTTONUP:
-				{
-					s_APIDefs->GameBinds.Release(Config::RedirectRMB_Target);
-
-					/* Releases should always be passed on. */
-					return 1;
-				}
+				break;
 			}
 		}
 
-		return 1;
+		return s_Handler.Process(message) ? 0 : 1;
 	}
 
-	void PreRender()
+	void ProcessKeybind(const char* aIdentifier, bool aIsRelease)
 	{
-		static bool s_CursorWasHidden = false;
-		static bool s_WasActive = false;
-
-		/* Do not evaluate state changes while not in gameplay. */
-		if (!s_NexusLink->IsGameplay)
-		{
-			return;
-		}
+		/* Only one bind is registered. */
+		s_Handler.SetHoldSuspended(!aIsRelease);
+	}
 
-		/* Do not evaluate state changes while map is open. */
-		if (s_MumbleLink->Context.IsMapOpen)
-		{
-			return;
-		}
+	void OnWindowResized(void* aEventArgs)
+	{
+		/* WndProc owns the client area, querying here would race its WM_MOVE/WM_SIZE updates. */
+		s_Handler.InvalidateClientRect();
+		s_CacheInvalidations.fetch_add(1, std::memory_order_relaxed);
+	}
 
-		bool shouldActivate = false;
+	void OnIdentityUpdated(void* aEventArgs)
+	{
+		s_Handler.ResetIdentity();
+		s_IdentityStale.store(true, std::memory_order_release);
+		s_CacheInvalidations.fetch_add(1, std::memory_order_relaxed);
+	}
 
-		if (Config::ResetToCenter && s_CursorWasHidden && !Inputs::IsCursorHidden() && s_NexusLink->IsCameraMoving)
-		{
-			RECT rect{};
-			GetWindowRect(s_WindowHandle, &rect);
-			SetCursorPos((rect.right - rect.left) / 2, (rect.bottom - rect.top) / 2);
-		}
+	void OnAddonsChanged(void* aEventArgs)
+	{
+		/* RTAPI may have come or gone, other addons may have bound game binds. */
+		s_RtapiStale.store(true, std::memory_order_release);
+		s_BoundStale.store(true, std::memory_order_release);
+		s_CacheInvalidations.fetch_add(2, std::memory_order_relaxed);
+	}
 
-		s_CursorWasHidden = Inputs::IsCursorHidden();
+	void PreRender()
+	{
+		Profiler::Scope profile(Profiler::EEntry_PreRender);
 
-		if (Config::EnableWhileMoving && s_NexusLink->IsMoving)
-		{
-			shouldActivate = true;
-		}
-		if (Config::EnableInCombat && s_MumbleLink->Context.IsInCombat)
-		{
-			shouldActivate = true;
-		}
-		if (Config::EnableOnMount && s_MumbleLink->Context.MountIndex != Mumble::EMountIndex::None)
+		/* The options were closed while waiting for a key, do not swallow the next one. */
+		if (++s_Frame - s_OptionsFrame > 1 && s_KeyCapture.load(std::memory_order_relaxed) != -1)
 		{
-			shouldActivate = true;
+			s_KeyCapture.store(-1);
 		}
 
-		//                      ui is ticking           && cursor not visible
-		bool cursorControlled = s_NexusLink->IsGameplay && Inputs::IsCursorHidden();
+		const ImGuiIO& io = ImGui::GetIO();
+		s_Handler.Frame(io.WantCaptureMouse, io.WantCaptureKeyboard);
+	}
+
+	/* Per game bind: 0 unknown, 1 unbound, 2 bound. Options render thread only. */
+	static uint8_t s_BoundCache[1024] = {};
 
-		//  is active        && should be active
-		if (cursorControlled && shouldActivate)
+	///----------------------------------------------------------------------------------------------------
+	/// IsBound:
+	/// 	Returns whether a game bind is bound within Nexus, cached until the binds may have changed.
+	///----------------------------------------------------------------------------------------------------
+	static bool IsBound(EGameBinds aGameBind)
+	{
+		if (s_BoundStale.load(std::memory_order_relaxed) && s_BoundStale.exchange(false, std::memory_order_acq_rel))
 		{
-			/* nop */
+			std::fill(std::begin(s_BoundCache), std::end(s_BoundCache), 0);
 		}
-		//       not active        && should be active
-		else if (!cursorControlled && shouldActivate)
+
+		if ((uint32_t)aGameBind >= std::size(s_BoundCache))
 		{
-			if (s_WasActive) // must be manual override
-			{
-				/* nop */
-			}
-			else
-			{
-				s_APIDefs->GameBinds.InvokeAsync(EGameBinds_CameraActionMode, 0);
-				s_WasActive = shouldActivate;
-			}
+			return s_APIDefs->GameBinds.IsBound(aGameBind);
 		}
-		//       is active        && should not be active
-		else if (cursorControlled && !shouldActivate)
+
+		uint8_t& cached = s_BoundCache[aGameBind];
+		if (cached)
 		{
-			if (s_WasActive)
-			{
-				s_APIDefs->GameBinds.InvokeAsync(EGameBinds_CameraActionMode, 0);
-				s_WasActive = shouldActivate;
-			}
-			else
-			{
-				/* not sure if this is reachable */
-			}
+			s_CacheHits.fetch_add(1, std::memory_order_relaxed);
 		}
-		//       not active        && should not be active
-		else if (!cursorControlled && !shouldActivate)
+		else
 		{
-			/* nop */
+			cached = s_APIDefs->GameBinds.IsBound(aGameBind) ? 2 : 1;
 		}
+
+		return cached == 2;
 	}
 
-	void GbSelectable(EGameBinds* aTarget, const char* aLabel, EGameBinds aGameBind)
+	void GbSelectable(Input::Bind* aTarget, const char* aLabel, EGameBinds aGameBind)
 	{
-		bool isBound = s_APIDefs->GameBinds.IsBound(aGameBind);
+		bool isBound = IsBound(aGameBind);
 
 		if (!isBound)
 		{
 			ImGui::PushStyleColor(ImGuiCol_Text, (ImVec4)ImColor(255, 255, 0, 255));
 		}
 
-		if (ImGui::Selectable((s_APIDefs->Localization.Translate(aLabel) + ("##" + std::to_string(aGameBind))).c_str()))
+		ImGui::PushID(aGameBind);
+		if (ImGui::Selectable(s_APIDefs->Localization.Translate(aLabel)))
 		{
 			*aTarget = aGameBind;
 			SaveSettings();
 		}
+		ImGui::PopID();
 
 		if (!isBound)
 		{
@@ -263,594 +692,603 @@ namespace Addon
 		}
 	}
 
-	std::string GameBindToString(EGameBinds aGameBind)
-	{
-		static std::map<EGameBinds, std::string> s_LUT =
-		{
-			// Movement
-			{ EGameBinds_MoveForward, "((MoveForward))" },
-			{ EGameBinds_MoveBackward, "((MoveBackward))" },
-			{ EGameBinds_MoveLeft, "((MoveLeft))" },
-			{ EGameBinds_MoveRight, "((MoveRight))" },
-			{ EGameBinds_MoveTurnLeft, "((MoveTurnLeft))" },
-			{ EGameBinds_MoveTurnRight, "((MoveTurnRight))" },
-			{ EGameBinds_MoveDodge, "((MoveDodge))" },
-			{ EGameBinds_MoveAutoRun, "((MoveAutoRun))" },
-			{ EGameBinds_MoveWalk, "((MoveWalk))" },
-			{ EGameBinds_MoveJump_SwimUp_FlyUp, "((MoveJump))"},
-			{ EGameBinds_MoveSwimDown_FlyDown, "((MoveSwimDown))" },
-			{ EGameBinds_MoveAboutFace, "((MoveAboutFace))" },
-
-			// Skills
-			{ EGameBinds_SkillWeaponSwap, "((SkillWeaponSwap))" },
-			{ EGameBinds_SkillWeapon1, "((SkillWeapon1))" },
-			{ EGameBinds_SkillWeapon2, "((SkillWeapon2))" },
-			{ EGameBinds_SkillWeapon3, "((SkillWeapon3))" },
-			{ EGameBinds_SkillWeapon4, "((SkillWeapon4))" },
-			{ EGameBinds_SkillWeapon5, "((SkillWeapon5))" },
-			{ EGameBinds_SkillHeal, "((SkillHeal))" },
-			{ EGameBinds_SkillUtility1, "((SkillUtility1))" },
-			{ EGameBinds_SkillUtility2, "((SkillUtility2))" },
-			{ EGameBinds_SkillUtility3, "((SkillUtility3))" },
-			{ EGameBinds_SkillElite, "((SkillElite))" },
-			{ EGameBinds_SkillProfession1, "((SkillProfession1))" },
-			{ EGameBinds_SkillProfession2, "((SkillProfession2))" },
-			{ EGameBinds_SkillProfession3, "((SkillProfession3))" },
-			{ EGameBinds_SkillProfession4, "((SkillProfession4))" },
-			{ EGameBinds_SkillProfession5, "((SkillProfession5))" },
-			{ EGameBinds_SkillProfession6, "((SkillProfession6))" },
-			{ EGameBinds_SkillProfession7, "((SkillProfession7))" },
-			{ EGameBinds_SkillSpecialAction, "((SkillSpecialAction))" },
-
-			// Targeting
-			{ EGameBinds_TargetAlert, "((TargetAlert))" },
-			{ EGameBinds_TargetCall, "((TargetCall))" },
-			{ EGameBinds_TargetTake, "((TargetTake))" },
-			{ EGameBinds_TargetCallLocal, "((TargetCallLocal))" },
-			{ EGameBinds_TargetTakeLocal, "((TargetTakeLocal))" },
-			{ EGameBinds_TargetEnemyNearest, "((TargetEnemyNearest))" },
-			{ EGameBinds_TargetEnemyNext, "((TargetEnemyNext))" },
-			{ EGameBinds_TargetEnemyPrev, "((TargetEnemyPrev))" },
-			{ EGameBinds_TargetAllyNearest, "((TargetAllyNearest))" },
-			{ EGameBinds_TargetAllyNext, "((TargetAllyNext))" },
-			{ EGameBinds_TargetAllyPrev, "((TargetAllyPrev))" },
-			{ EGameBinds_TargetLock, "((TargetLock))" },
-			{ EGameBinds_TargetSnapGroundTarget, "((TargetSnapGroundTarget))" },
-			{ EGameBinds_TargetSnapGroundTargetToggle, "((TargetSnapGroundTargetToggle))" },
-			{ EGameBinds_TargetAutoTargetingDisable, "((TargetAutoTargetingDisable))" },
-			{ EGameBinds_TargetAutoTargetingToggle, "((TargetAutoTargetingToggle))" },
-			{ EGameBinds_TargetAllyTargetingMode, "((TargetAllyTargetingMode))" },
-			{ EGameBinds_TargetAllyTargetingModeToggle, "((TargetAllyTargetingModeToggle))" },
-
-			// UI Binds
-			{ EGameBinds_UiCommerce, "((UiCommerce))" }, // TradingPost
-			{ EGameBinds_UiContacts, "((UiContacts))" },
-			{ EGameBinds_UiGuild, "((UiGuild))" },
-			{ EGameBinds_UiHero, "((UiHero))" },
-			{ EGameBinds_UiInventory, "((UiInventory))" },
-			{ EGameBinds_UiKennel, "((UiKennel))" }, // Pets
-			{ EGameBinds_UiLogout, "((UiLogout))" },
-			{ EGameBinds_UiMail, "((UiMail))" },
-			{ EGameBinds_UiOptions, "((UiOptions))" },
-			{ EGameBinds_UiParty, "((UiParty))" },
-			{ EGameBinds_UiPvp, "((UiPvp))" },
-			{ EGameBinds_UiPvpBuild, "((UiPvpBuild))" },
-			{ EGameBinds_UiScoreboard, "((UiScoreboard))" },
-			{ EGameBinds_UiSeasonalObjectivesShop, "((UiSeasonalObjectivesShop))" }, // Wizard's Vault
-			{ EGameBinds_UiInformation, "((UiInformation))" },
-			{ EGameBinds_UiChatToggle, "((UiChatToggle))" },
-			{ EGameBinds_UiChatCommand, "((UiChatCommand))" },
-			{ EGameBinds_UiChatFocus, "((UiChatFocus))" },
-			{ EGameBinds_UiChatReply, "((UiChatReply))" },
-			{ EGameBinds_UiToggle, "((UiToggle))" },
-			{ EGameBinds_UiSquadBroadcastChatToggle, "((UiSquadBroadcastChatToggle))" },
-			{ EGameBinds_UiSquadBroadcastChatCommand, "((UiSquadBroadcastChatCommand))" },
-			{ EGameBinds_UiSquadBroadcastChatFocus, "((UiSquadBroadcastChatFocus))" },
-
-			// Camera
-			{ EGameBinds_CameraFree, "((CameraFree))" },
-			{ EGameBinds_CameraZoomIn, "((CameraZoomIn))" },
-			{ EGameBinds_CameraZoomOut, "((CameraZoomOut))" },
-			{ EGameBinds_CameraReverse, "((CameraReverse))" },
-			{ EGameBinds_CameraActionMode, "((CameraActionMode))" },
-			{ EGameBinds_CameraActionModeDisable, "((CameraActionModeDisable))" },
-
-			// Screenshots
-			{ EGameBinds_ScreenshotNormal, "((ScreenshotNormal))" },
-			{ EGameBinds_ScreenshotStereoscopic, "((ScreenshotStereoscopic))" },
-
-			// Map
-			{ EGameBinds_MapToggle, "((MapToggle))" },
-			{ EGameBinds_MapFocusPlayer, "((MapFocusPlayer))" },
-			{ EGameBinds_MapFloorDown, "((MapFloorDown))" },
-			{ EGameBinds_MapFloorUp, "((MapFloorUp))" },
-			{ EGameBinds_MapZoomIn, "((MapZoomIn))" },
-			{ EGameBinds_MapZoomOut, "((MapZoomOut))" },
-
-			// Mounts
-			{ EGameBinds_SpumoniToggle, "((SpumoniToggle))" },
-			{ EGameBinds_SpumoniMovement, "((SpumoniMovement))" },
-			{ EGameBinds_SpumoniSecondaryMovement, "((SpumoniSecondaryMovement))" },
-			{ EGameBinds_SpumoniMAM01, "((SpumoniMAM01))" }, // Raptor
-			{ EGameBinds_SpumoniMAM02, "((SpumoniMAM02))" }, // Springer
-			{ EGameBinds_SpumoniMAM03, "((SpumoniMAM03))" }, // Skimmer
-			{ EGameBinds_SpumoniMAM04, "((SpumoniMAM04))" }, // Jackal
-			{ EGameBinds_SpumoniMAM05, "((SpumoniMAM05))" }, // Griffon
-			{ EGameBinds_SpumoniMAM06, "((SpumoniMAM06))" }, // RollerBeetle
-			{ EGameBinds_SpumoniMAM07, "((SpumoniMAM07))" }, // Warclaw
-			{ EGameBinds_SpumoniMAM08, "((SpumoniMAM08))" }, // Skyscale
-			{ EGameBinds_SpumoniMAM09, "((SpumoniMAM09))" }, // SiegeTurtle
-
-			// Spectator Binds
-			{ EGameBinds_SpectatorNearestFixed, "((SpectatorNearestFixed))" },
-			{ EGameBinds_SpectatorNearestPlayer, "((SpectatorNearestPlayer))" },
-			{ EGameBinds_SpectatorPlayerRed1, "((SpectatorPlayerRed1))" },
-			{ EGameBinds_SpectatorPlayerRed2, "((SpectatorPlayerRed2))" },
-			{ EGameBinds_SpectatorPlayerRed3, "((SpectatorPlayerRed3))" },
-			{ EGameBinds_SpectatorPlayerRed4, "((SpectatorPlayerRed4))" },
-			{ EGameBinds_SpectatorPlayerRed5, "((SpectatorPlayerRed5))" },
-			{ EGameBinds_SpectatorPlayerBlue1, "((SpectatorPlayerBlue1))" },
-			{ EGameBinds_SpectatorPlayerBlue2, "((SpectatorPlayerBlue2))" },
-			{ EGameBinds_SpectatorPlayerBlue3, "((SpectatorPlayerBlue3))" },
-			{ EGameBinds_SpectatorPlayerBlue4, "((SpectatorPlayerBlue4))" },
-			{ EGameBinds_SpectatorPlayerBlue5, "((SpectatorPlayerBlue5))" },
-			{ EGameBinds_SpectatorFreeCamera, "((SpectatorFreeCamera))" },
-			{ EGameBinds_SpectatorFreeCameraMode, "((SpectatorFreeCameraMode))" },
-			{ EGameBinds_SpectatorFreeMoveForward, "((SpectatorFreeMoveForward))" },
-			{ EGameBinds_SpectatorFreeMoveBackward, "((SpectatorFreeMoveBackward))" },
-			{ EGameBinds_SpectatorFreeMoveLeft, "((SpectatorFreeMoveLeft))" },
-			{ EGameBinds_SpectatorFreeMoveRight, "((SpectatorFreeMoveRight))" },
-			{ EGameBinds_SpectatorFreeMoveUp, "((SpectatorFreeMoveUp))" },
-			{ EGameBinds_SpectatorFreeMoveDown, "((SpectatorFreeMoveDown))" },
-
-			// Squad Markers
-			{ EGameBinds_SquadMarkerPlaceWorld1, "((SquadMarkerPlaceWorld1))" }, // Arrow
-			{ EGameBinds_SquadMarkerPlaceWorld2, "((SquadMarkerPlaceWorld2))" }, // Circle
-			{ EGameBinds_SquadMarkerPlaceWorld3, "((SquadMarkerPlaceWorld3))" }, // Heart
-			{ EGameBinds_SquadMarkerPlaceWorld4, "((SquadMarkerPlaceWorld4))" }, // Square
-			{ EGameBinds_SquadMarkerPlaceWorld5, "((SquadMarkerPlaceWorld5))" }, // Star
-			{ EGameBinds_SquadMarkerPlaceWorld6, "((SquadMarkerPlaceWorld6))" }, // Swirl
-			{ EGameBinds_SquadMarkerPlaceWorld7, "((SquadMarkerPlaceWorld7))" }, // Triangle
-			{ EGameBinds_SquadMarkerPlaceWorld8, "((SquadMarkerPlaceWorld8))" }, // Cross
-			{ EGameBinds_SquadMarkerClearAllWorld, "((SquadMarkerClearAllWorld))" },
-			{ EGameBinds_SquadMarkerSetAgent1, "((SquadMarkerSetAgent1))" }, // Arrow
-			{ EGameBinds_SquadMarkerSetAgent2, "((SquadMarkerSetAgent2))" }, // Circle
-			{ EGameBinds_SquadMarkerSetAgent3, "((SquadMarkerSetAgent3))" }, // Heart
-			{ EGameBinds_SquadMarkerSetAgent4, "((SquadMarkerSetAgent4))" }, // Square
-			{ EGameBinds_SquadMarkerSetAgent5, "((SquadMarkerSetAgent5))" }, // Star
-			{ EGameBinds_SquadMarkerSetAgent6, "((SquadMarkerSetAgent6))" }, // Swirl
-			{ EGameBinds_SquadMarkerSetAgent7, "((SquadMarkerSetAgent7))" }, // Triangle
-			{ EGameBinds_SquadMarkerSetAgent8, "((SquadMarkerSetAgent8))" }, // Cross
-			{ EGameBinds_SquadMarkerClearAllAgent, "((SquadMarkerClearAllAgent))" },
-
-			// Mastery Skills
-			{ EGameBinds_MasteryAccess, "((MasteryAccess))" },
-			{ EGameBinds_MasteryAccess01, "((MasteryAccess01))" }, // Fishing
-			{ EGameBinds_MasteryAccess02, "((MasteryAccess02))" }, // Skiff
-			{ EGameBinds_MasteryAccess03, "((MasteryAccess03))" }, // Jade Bot Waypoint
-			{ EGameBinds_MasteryAccess04, "((MasteryAccess04))" }, // Rift Scan
-			{ EGameBinds_MasteryAccess05, "((MasteryAccess05))" }, // Skyscale
-			{ EGameBinds_MasteryAccess06, "((MasteryAccess06))" }, // Homestead Doorway
-
-			// Miscellaneous Binds
-			{ EGameBinds_MiscAoELoot, "((MiscAoELoot))" },
-			{ EGameBinds_MiscInteract, "((MiscInteract))" },
-			{ EGameBinds_MiscShowEnemies, "((MiscShowEnemies))" },
-			{ EGameBinds_MiscShowAllies, "((MiscShowAllies))" },
-			{ EGameBinds_MiscCombatStance, "((MiscCombatStance))" }, // Stow/Draw
-			{ EGameBinds_MiscToggleLanguage, "((MiscToggleLanguage))" },
-			{ EGameBinds_MiscTogglePetCombat, "((MiscTogglePetCombat))" },
-			{ EGameBinds_MiscToggleFullScreen, "((MiscToggleFullScreen))" },
-			{ EGameBinds_MiscToggleDecorationMode, "((MiscToggleDecorationMode))" }, // Decoration Mode
-
-			// Toys/Novelties
-			{ EGameBinds_ToyUseDefault, "((ToyUseDefault))" },
-			{ EGameBinds_ToyUseSlot1, "((ToyUseSlot1))" }, // Chair
-			{ EGameBinds_ToyUseSlot2, "((ToyUseSlot2))" }, // Instrument
-			{ EGameBinds_ToyUseSlot3, "((ToyUseSlot3))" }, // Held Item
-			{ EGameBinds_ToyUseSlot4, "((ToyUseSlot4))" }, // Toy
-			{ EGameBinds_ToyUseSlot5, "((ToyUseSlot5))" }, // Tonic
-			//ToyUseSlot6 unused
-
-			// Build Templates
-			{ EGameBinds_Loadout1, "((Loadout1))" },
-			{ EGameBinds_Loadout2, "((Loadout2))" },
-			{ EGameBinds_Loadout3, "((Loadout3))" },
-			{ EGameBinds_Loadout4, "((Loadout4))" },
-			{ EGameBinds_Loadout5, "((Loadout5))" },
-			{ EGameBinds_Loadout6, "((Loadout6))" },
-			{ EGameBinds_Loadout7, "((Loadout7))" },
-			{ EGameBinds_Loadout8, "((Loadout8))" },
-			{ EGameBinds_Loadout9, "((Loadout9))" },
-
-			// Equipment Templates
-			{ EGameBinds_GearLoadout1, "((GearLoadout1))" },
-			{ EGameBinds_GearLoadout2, "((GearLoadout2))" },
-			{ EGameBinds_GearLoadout3, "((GearLoadout3))" },
-			{ EGameBinds_GearLoadout4, "((GearLoadout4))" },
-			{ EGameBinds_GearLoadout5, "((GearLoadout5))" },
-			{ EGameBinds_GearLoadout6, "((GearLoadout6))" },
-			{ EGameBinds_GearLoadout7, "((GearLoadout7))" },
-			{ EGameBinds_GearLoadout8, "((GearLoadout8))" },
-			{ EGameBinds_GearLoadout9, "((GearLoadout9))" }
-		};
-
-		return s_LUT[aGameBind];
-	}
+	///----------------------------------------------------------------------------------------------------
+	/// OptionsUi:
+	/// 	Renders GameBinds::Selector with ImGui, translated by Nexus.
+	///----------------------------------------------------------------------------------------------------
+	struct OptionsUi
+	{
+		bool BeginCombo(const char* aIdentifier, const char* aPreview)
+		{
+			return ImGui::BeginCombo(aIdentifier, s_APIDefs->Localization.Translate(aPreview));
+		}
 
-	void GbSelector(const char* aIdentifier, EGameBinds* aTarget)
-	{
-		if (ImGui::BeginCombo(aIdentifier, s_APIDefs->Localization.Translate(GameBindToString(*aTarget).c_str())))
-		{
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Movement))")))
-			{
-				GbSelectable(aTarget, "((MoveForward))", EGameBinds_MoveForward);
-				GbSelectable(aTarget, "((MoveBackward))", EGameBinds_MoveBackward);
-				GbSelectable(aTarget, "((MoveLeft))", EGameBinds_MoveLeft);
-				GbSelectable(aTarget, "((MoveRight))", EGameBinds_MoveRight);
-				GbSelectable(aTarget, "((MoveTurnLeft))", EGameBinds_MoveTurnLeft);
-				GbSelectable(aTarget, "((MoveTurnRight))", EGameBinds_MoveTurnRight);
-				GbSelectable(aTarget, "((MoveDodge))", EGameBinds_MoveDodge);
-				GbSelectable(aTarget, "((MoveAutoRun))", EGameBinds_MoveAutoRun);
-				GbSelectable(aTarget, "((MoveWalk))", EGameBinds_MoveWalk);
-				GbSelectable(aTarget, "((MoveJump))", EGameBinds_MoveJump_SwimUp_FlyUp);
-				GbSelectable(aTarget, "((MoveSwimDown))", EGameBinds_MoveSwimDown_FlyDown);
-				GbSelectable(aTarget, "((MoveAboutFace))", EGameBinds_MoveAboutFace);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Skills))")))
-			{
-				GbSelectable(aTarget, "((SkillWeaponSwap))", EGameBinds_SkillWeaponSwap);
-				GbSelectable(aTarget, "((SkillWeapon1))", EGameBinds_SkillWeapon1);
-				GbSelectable(aTarget, "((SkillWeapon2))", EGameBinds_SkillWeapon2);
-				GbSelectable(aTarget, "((SkillWeapon3))", EGameBinds_SkillWeapon3);
-				GbSelectable(aTarget, "((SkillWeapon4))", EGameBinds_SkillWeapon4);
-				GbSelectable(aTarget, "((SkillWeapon5))", EGameBinds_SkillWeapon5);
-				GbSelectable(aTarget, "((SkillHeal))", EGameBinds_SkillHeal);
-				GbSelectable(aTarget, "((SkillUtility1))", EGameBinds_SkillUtility1);
-				GbSelectable(aTarget, "((SkillUtility2))", EGameBinds_SkillUtility2);
-				GbSelectable(aTarget, "((SkillUtility3))", EGameBinds_SkillUtility3);
-				GbSelectable(aTarget, "((SkillElite))", EGameBinds_SkillElite);
-				GbSelectable(aTarget, "((SkillProfession1))", EGameBinds_SkillProfession1);
-				GbSelectable(aTarget, "((SkillProfession2))", EGameBinds_SkillProfession2);
-				GbSelectable(aTarget, "((SkillProfession3))", EGameBinds_SkillProfession3);
-				GbSelectable(aTarget, "((SkillProfession4))", EGameBinds_SkillProfession4);
-				GbSelectable(aTarget, "((SkillProfession5))", EGameBinds_SkillProfession5);
-				GbSelectable(aTarget, "((SkillProfession6))", EGameBinds_SkillProfession6);
-				GbSelectable(aTarget, "((SkillProfession7))", EGameBinds_SkillProfession7);
-				GbSelectable(aTarget, "((SkillSpecialAction))", EGameBinds_SkillSpecialAction);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Targeting))")))
-			{
-				GbSelectable(aTarget, "((TargetAlert))", EGameBinds_TargetAlert);
-				GbSelectable(aTarget, "((TargetCall))", EGameBinds_TargetCall);
-				GbSelectable(aTarget, "((TargetTake))", EGameBinds_TargetTake);
-				GbSelectable(aTarget, "((TargetCallLocal))", EGameBinds_TargetCallLocal);
-				GbSelectable(aTarget, "((TargetTakeLocal))", EGameBinds_TargetTakeLocal);
-				GbSelectable(aTarget, "((TargetEnemyNearest))", EGameBinds_TargetEnemyNearest);
-				GbSelectable(aTarget, "((TargetEnemyNext))", EGameBinds_TargetEnemyNext);
-				GbSelectable(aTarget, "((TargetEnemyPrev))", EGameBinds_TargetEnemyPrev);
-				GbSelectable(aTarget, "((TargetAllyNearest))", EGameBinds_TargetAllyNearest);
-				GbSelectable(aTarget, "((TargetAllyNext))", EGameBinds_TargetAllyNext);
-				GbSelectable(aTarget, "((TargetAllyPrev))", EGameBinds_TargetAllyPrev);
-				GbSelectable(aTarget, "((TargetLock))", EGameBinds_TargetLock);
-				GbSelectable(aTarget, "((TargetSnapGroundTarget))", EGameBinds_TargetSnapGroundTarget);
-				GbSelectable(aTarget, "((TargetSnapGroundTargetToggle))", EGameBinds_TargetSnapGroundTargetToggle);
-				GbSelectable(aTarget, "((TargetAutoTargetingDisable))", EGameBinds_TargetAutoTargetingDisable);
-				GbSelectable(aTarget, "((TargetAutoTargetingToggle))", EGameBinds_TargetAutoTargetingToggle);
-				GbSelectable(aTarget, "((TargetAllyTargetingMode))", EGameBinds_TargetAllyTargetingMode);
-				GbSelectable(aTarget, "((TargetAllyTargetingModeToggle))", EGameBinds_TargetAllyTargetingModeToggle);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((User Interface))")))
-			{
-				GbSelectable(aTarget, "((UiCommerce))", EGameBinds_UiCommerce);
-				GbSelectable(aTarget, "((UiContacts))", EGameBinds_UiContacts);
-				GbSelectable(aTarget, "((UiGuild))", EGameBinds_UiGuild);
-				GbSelectable(aTarget, "((UiHero))", EGameBinds_UiHero);
-				GbSelectable(aTarget, "((UiInventory))", EGameBinds_UiInventory);
-				GbSelectable(aTarget, "((UiKennel))", EGameBinds_UiKennel);
-				GbSelectable(aTarget, "((UiLogout))", EGameBinds_UiLogout);
-				GbSelectable(aTarget, "((UiMail))", EGameBinds_UiMail);
-				GbSelectable(aTarget, "((UiOptions))", EGameBinds_UiOptions);
-				GbSelectable(aTarget, "((UiParty))", EGameBinds_UiParty);
-				GbSelectable(aTarget, "((UiPvp))", EGameBinds_UiPvp);
-				GbSelectable(aTarget, "((UiPvpBuild))", EGameBinds_UiPvpBuild);
-				GbSelectable(aTarget, "((UiScoreboard))", EGameBinds_UiScoreboard);
-				GbSelectable(aTarget, "((UiSeasonalObjectivesShop))", EGameBinds_UiSeasonalObjectivesShop);
-				GbSelectable(aTarget, "((UiInformation))", EGameBinds_UiInformation);
-				GbSelectable(aTarget, "((UiChatToggle))", EGameBinds_UiChatToggle);
-				GbSelectable(aTarget, "((UiChatCommand))", EGameBinds_UiChatCommand);
-				GbSelectable(aTarget, "((UiChatFocus))", EGameBinds_UiChatFocus);
-				GbSelectable(aTarget, "((UiChatReply))", EGameBinds_UiChatReply);
-				GbSelectable(aTarget, "((UiToggle))", EGameBinds_UiToggle);
-				GbSelectable(aTarget, "((UiSquadBroadcastChatToggle))", EGameBinds_UiSquadBroadcastChatToggle);
-				GbSelectable(aTarget, "((UiSquadBroadcastChatCommand))", EGameBinds_UiSquadBroadcastChatCommand);
-				GbSelectable(aTarget, "((UiSquadBroadcastChatFocus))", EGameBinds_UiSquadBroadcastChatFocus);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Camera))")))
-			{
-				GbSelectable(aTarget, "((CameraFree))", EGameBinds_CameraFree);
-				GbSelectable(aTarget, "((CameraZoomIn))", EGameBinds_CameraZoomIn);
-				GbSelectable(aTarget, "((CameraZoomOut))", EGameBinds_CameraZoomOut);
-				GbSelectable(aTarget, "((CameraReverse))", EGameBinds_CameraReverse);
-				GbSelectable(aTarget, "((CameraActionMode))", EGameBinds_CameraActionMode);
-				GbSelectable(aTarget, "((CameraActionModeDisable))", EGameBinds_CameraActionModeDisable);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Screenshot))")))
-			{
-				GbSelectable(aTarget, "((ScreenshotNormal))", EGameBinds_ScreenshotNormal);
-				GbSelectable(aTarget, "((ScreenshotStereoscopic))", EGameBinds_ScreenshotStereoscopic);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Map))")))
-			{
-				GbSelectable(aTarget, "((MapToggle))", EGameBinds_MapToggle);
-				GbSelectable(aTarget, "((MapFocusPlayer))", EGameBinds_MapFocusPlayer);
-				GbSelectable(aTarget, "((MapFloorDown))", EGameBinds_MapFloorDown);
-				GbSelectable(aTarget, "((MapFloorUp))", EGameBinds_MapFloorUp);
-				GbSelectable(aTarget, "((MapZoomIn))", EGameBinds_MapZoomIn);
-				GbSelectable(aTarget, "((MapZoomOut))", EGameBinds_MapZoomOut);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Mounts))")))
-			{
-				GbSelectable(aTarget, "((SpumoniToggle))", EGameBinds_SpumoniToggle);
-				GbSelectable(aTarget, "((SpumoniMovement))", EGameBinds_SpumoniMovement);
-				GbSelectable(aTarget, "((SpumoniSecondaryMovement))", EGameBinds_SpumoniSecondaryMovement);
-				GbSelectable(aTarget, "((SpumoniMAM01))", EGameBinds_SpumoniMAM01);
-				GbSelectable(aTarget, "((SpumoniMAM02))", EGameBinds_SpumoniMAM02);
-				GbSelectable(aTarget, "((SpumoniMAM03))", EGameBinds_SpumoniMAM03);
-				GbSelectable(aTarget, "((SpumoniMAM04))", EGameBinds_SpumoniMAM04);
-				GbSelectable(aTarget, "((SpumoniMAM05))", EGameBinds_SpumoniMAM05);
-				GbSelectable(aTarget, "((SpumoniMAM06))", EGameBinds_SpumoniMAM06);
-				GbSelectable(aTarget, "((SpumoniMAM07))", EGameBinds_SpumoniMAM07);
-				GbSelectable(aTarget, "((SpumoniMAM08))", EGameBinds_SpumoniMAM08);
-				GbSelectable(aTarget, "((SpumoniMAM09))", EGameBinds_SpumoniMAM09);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Spectators))")))
-			{
-				GbSelectable(aTarget, "((SpectatorNearestFixed))", EGameBinds_SpectatorNearestFixed);
-				GbSelectable(aTarget, "((SpectatorNearestPlayer))", EGameBinds_SpectatorNearestPlayer);
-				GbSelectable(aTarget, "((SpectatorPlayerRed1))", EGameBinds_SpectatorPlayerRed1);
-				GbSelectable(aTarget, "((SpectatorPlayerRed2))", EGameBinds_SpectatorPlayerRed2);
-				GbSelectable(aTarget, "((SpectatorPlayerRed3))", EGameBinds_SpectatorPlayerRed3);
-				GbSelectable(aTarget, "((SpectatorPlayerRed4))", EGameBinds_SpectatorPlayerRed4);
-				GbSelectable(aTarget, "((SpectatorPlayerRed5))", EGameBinds_SpectatorPlayerRed5);
-				GbSelectable(aTarget, "((SpectatorPlayerBlue1))", EGameBinds_SpectatorPlayerBlue1);
-				GbSelectable(aTarget, "((SpectatorPlayerBlue2))", EGameBinds_SpectatorPlayerBlue2);
-				GbSelectable(aTarget, "((SpectatorPlayerBlue3))", EGameBinds_SpectatorPlayerBlue3);
-				GbSelectable(aTarget, "((SpectatorPlayerBlue4))", EGameBinds_SpectatorPlayerBlue4);
-				GbSelectable(aTarget, "((SpectatorPlayerBlue5))", EGameBinds_SpectatorPlayerBlue5);
-				GbSelectable(aTarget, "((SpectatorFreeCamera))", EGameBinds_SpectatorFreeCamera);
-				GbSelectable(aTarget, "((SpectatorFreeCameraMode))", EGameBinds_SpectatorFreeCameraMode);
-				GbSelectable(aTarget, "((SpectatorFreeMoveForward))", EGameBinds_SpectatorFreeMoveForward);
-				GbSelectable(aTarget, "((SpectatorFreeMoveBackward))", EGameBinds_SpectatorFreeMoveBackward);
-				GbSelectable(aTarget, "((SpectatorFreeMoveLeft))", EGameBinds_SpectatorFreeMoveLeft);
-				GbSelectable(aTarget, "((SpectatorFreeMoveRight))", EGameBinds_SpectatorFreeMoveRight);
-				GbSelectable(aTarget, "((SpectatorFreeMoveUp))", EGameBinds_SpectatorFreeMoveUp);
-				GbSelectable(aTarget, "((SpectatorFreeMoveDown))", EGameBinds_SpectatorFreeMoveDown);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Squad))")))
-			{
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld1))", EGameBinds_SquadMarkerPlaceWorld1);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld2))", EGameBinds_SquadMarkerPlaceWorld2);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld3))", EGameBinds_SquadMarkerPlaceWorld3);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld4))", EGameBinds_SquadMarkerPlaceWorld4);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld5))", EGameBinds_SquadMarkerPlaceWorld5);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld6))", EGameBinds_SquadMarkerPlaceWorld6);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld7))", EGameBinds_SquadMarkerPlaceWorld7);
-				GbSelectable(aTarget, "((SquadMarkerPlaceWorld8))", EGameBinds_SquadMarkerPlaceWorld8);
-				GbSelectable(aTarget, "((SquadMarkerClearAllWorld))", EGameBinds_SquadMarkerClearAllWorld);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent1))", EGameBinds_SquadMarkerSetAgent1);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent2))", EGameBinds_SquadMarkerSetAgent2);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent3))", EGameBinds_SquadMarkerSetAgent3);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent4))", EGameBinds_SquadMarkerSetAgent4);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent5))", EGameBinds_SquadMarkerSetAgent5);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent6))", EGameBinds_SquadMarkerSetAgent6);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent7))", EGameBinds_SquadMarkerSetAgent7);
-				GbSelectable(aTarget, "((SquadMarkerSetAgent8))", EGameBinds_SquadMarkerSetAgent8);
-				GbSelectable(aTarget, "((SquadMarkerClearAllAgent))", EGameBinds_SquadMarkerClearAllAgent);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Mastery Skills))")))
-			{
-				GbSelectable(aTarget, "((MasteryAccess))", EGameBinds_MasteryAccess);
-				GbSelectable(aTarget, "((MasteryAccess01))", EGameBinds_MasteryAccess01);
-				GbSelectable(aTarget, "((MasteryAccess02))", EGameBinds_MasteryAccess02);
-				GbSelectable(aTarget, "((MasteryAccess03))", EGameBinds_MasteryAccess03);
-				GbSelectable(aTarget, "((MasteryAccess04))", EGameBinds_MasteryAccess04);
-				GbSelectable(aTarget, "((MasteryAccess05))", EGameBinds_MasteryAccess05);
-				GbSelectable(aTarget, "((MasteryAccess06))", EGameBinds_MasteryAccess06);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Miscellaneous))")))
-			{
-				GbSelectable(aTarget, "((MiscAoELoot))", EGameBinds_MiscAoELoot);
-				GbSelectable(aTarget, "((MiscInteract))", EGameBinds_MiscInteract);
-				GbSelectable(aTarget, "((MiscShowEnemies))", EGameBinds_MiscShowEnemies);
-				GbSelectable(aTarget, "((MiscShowAllies))", EGameBinds_MiscShowAllies);
-				GbSelectable(aTarget, "((MiscCombatStance))", EGameBinds_MiscCombatStance);
-				GbSelectable(aTarget, "((MiscToggleLanguage))", EGameBinds_MiscToggleLanguage);
-				GbSelectable(aTarget, "((MiscTogglePetCombat))", EGameBinds_MiscTogglePetCombat);
-				GbSelectable(aTarget, "((MiscToggleFullScreen))", EGameBinds_MiscToggleFullScreen);
-				GbSelectable(aTarget, "((MiscToggleDecorationMode))", EGameBinds_MiscToggleDecorationMode);
-				GbSelectable(aTarget, "((ToyUseDefault))", EGameBinds_ToyUseDefault);
-				GbSelectable(aTarget, "((ToyUseSlot1))", EGameBinds_ToyUseSlot1);
-				GbSelectable(aTarget, "((ToyUseSlot2))", EGameBinds_ToyUseSlot2);
-				GbSelectable(aTarget, "((ToyUseSlot3))", EGameBinds_ToyUseSlot3);
-				GbSelectable(aTarget, "((ToyUseSlot4))", EGameBinds_ToyUseSlot4);
-				GbSelectable(aTarget, "((ToyUseSlot5))", EGameBinds_ToyUseSlot5);
-				ImGui::EndMenu();
-			}
-			if (ImGui::BeginMenu(s_APIDefs->Localization.Translate("((Templates))")))
-			{
-				GbSelectable(aTarget, "((Loadout1))", EGameBinds_Loadout1);
-				GbSelectable(aTarget, "((Loadout2))", EGameBinds_Loadout2);
-				GbSelectable(aTarget, "((Loadout3))", EGameBinds_Loadout3);
-				GbSelectable(aTarget, "((Loadout4))", EGameBinds_Loadout4);
-				GbSelectable(aTarget, "((Loadout5))", EGameBinds_Loadout5);
-				GbSelectable(aTarget, "((Loadout6))", EGameBinds_Loadout6);
-				GbSelectable(aTarget, "((Loadout7))", EGameBinds_Loadout7);
-				GbSelectable(aTarget, "((Loadout8))", EGameBinds_Loadout8);
-				GbSelectable(aTarget, "((Loadout9))", EGameBinds_Loadout9);
-				GbSelectable(aTarget, "((GearLoadout1))", EGameBinds_GearLoadout1);
-				GbSelectable(aTarget, "((GearLoadout2))", EGameBinds_GearLoadout2);
-				GbSelectable(aTarget, "((GearLoadout3))", EGameBinds_GearLoadout3);
-				GbSelectable(aTarget, "((GearLoadout4))", EGameBinds_GearLoadout4);
-				GbSelectable(aTarget, "((GearLoadout5))", EGameBinds_GearLoadout5);
-				GbSelectable(aTarget, "((GearLoadout6))", EGameBinds_GearLoadout6);
-				GbSelectable(aTarget, "((GearLoadout7))", EGameBinds_GearLoadout7);
-				GbSelectable(aTarget, "((GearLoadout8))", EGameBinds_GearLoadout8);
-				GbSelectable(aTarget, "((GearLoadout9))", EGameBinds_GearLoadout9);
-				ImGui::EndMenu();
-			}
+		void EndCombo()
+		{
 			ImGui::EndCombo();
 		}
+
+		bool BeginMenu(const char* aLabel)
+		{
+			return ImGui::BeginMenu(s_APIDefs->Localization.Translate(aLabel));
+		}
+
+		void EndMenu()
+		{
+			ImGui::EndMenu();
+		}
+
+		void Selectable(Input::Bind* aTarget, const char* aLabel, EGameBinds aGameBind)
+		{
+			GbSelectable(aTarget, aLabel, aGameBind);
+		}
+	};
+
+	void GbSelector(const char* aIdentifier, Input::Bind* aTarget)
+	{
+		OptionsUi ui;
+		GameBinds::Selector(ui, aIdentifier, aTarget);
 	}
 
 	void RenderOptions()
 	{
-		if (!s_APIDefs->GameBinds.IsBound(EGameBinds_CameraActionMode))
+		Profiler::Scope profile(Profiler::EEntry_RenderOptions);
+
+		s_OptionsFrame = s_Frame;
+
+		/* Binds are changed on the Nexus keybinds page, query them again whenever this page is reopened. */
+		static int s_LastFrame = -1;
+		int frame = ImGui::GetFrameCount();
+		if (frame != s_LastFrame + 1)
+		{
+			s_BoundStale.store(true, std::memory_order_release);
+			s_CacheInvalidations.fetch_add(1, std::memory_order_relaxed);
+		}
+		s_LastFrame = frame;
+
+		if (!IsBound(EGameBinds_CameraActionMode))
 		{
 			ImGui::TextColored(ImVec4(1.f, 1.f, 0.f, 1.f), "\"Toggle Action Camera\" not bound within Nexus.");
 			ImGui::TextColored(ImVec4(1.f, 1.f, 0.f, 1.f), "You can bind it from Keybinds -> Guild Wars 2. It should match your bind in game.");
 		}
 
 		ImGui::Text("UI/UX");
-		if (ImGui::Checkbox("Reset Cursor to Center after Action Cam", &Config::ResetToCenter))
+		if (ImGui::Checkbox("Reset Cursor to Center after Action Cam", &s_Config.ResetToCenter))
+		{
+			s_Config.RestoreCursor = s_Config.RestoreCursor && !s_Config.ResetToCenter;
+			SaveSettings();
+		}
+		if (ImGui::Checkbox("Restore Cursor to previous position after Action Cam", &s_Config.RestoreCursor))
 		{
+			s_Config.ResetToCenter = s_Config.ResetToCenter && !s_Config.RestoreCursor;
 			SaveSettings();
 		}
 
 		ImGui::Text("Activation");
-		if (ImGui::Checkbox("Enable while moving", &Config::EnableWhileMoving))
+		if (ImGui::Checkbox("Enable while moving", &s_Config.EnableWhileMoving))
+		{
+			SaveSettings();
+		}
+
+		if (ImGui::Checkbox("Enable in combat", &s_Config.EnableInCombat))
 		{
 			SaveSettings();
 		}
 
-		if (ImGui::Checkbox("Enable in combat", &Config::EnableInCombat))
+		if (ImGui::Checkbox("Enable while mounted", &s_Config.EnableOnMount))
 		{
 			SaveSettings();
 		}
 
-		if (ImGui::Checkbox("Enable while mounted", &Config::EnableOnMount))
+		if (ImGui::Checkbox("Enable when zoomed in", &s_Config.EnableWhenZoomedIn))
+		{
+			SaveSettings();
+		}
+		ImGui::TooltipGeneric("Camera distance to your character, e.g. first-person or over-the-shoulder.\nThe camera stays zoomed in until it moves past the zoom out distance.");
+		if (s_Config.EnableWhenZoomedIn)
+		{
+			if (ImGui::SliderFloat("Zoom in distance (m)", &s_Config.ZoomInDistance, 0.5f, 20.0f, "%.1f"))
+			{
+				s_Config.ZoomOutDistance = std::max(s_Config.ZoomOutDistance, s_Config.ZoomInDistance);
+			}
+			/* Sliders change on every frame they are dragged, save once they are let go. */
+			if (ImGui::IsItemDeactivatedAfterEdit())
+			{
+				SaveSettings();
+			}
+			if (ImGui::SliderFloat("Zoom out distance (m)", &s_Config.ZoomOutDistance, 0.5f, 20.0f, "%.1f"))
+			{
+				s_Config.ZoomInDistance = std::min(s_Config.ZoomInDistance, s_Config.ZoomOutDistance);
+			}
+			if (ImGui::IsItemDeactivatedAfterEdit())
+			{
+				SaveSettings();
+			}
+		}
+
+		ImGui::Text("Suspend");
+		ImGui::TextDisabled("Hold a key to suspend action cam: bind \"%s\" via the Nexus options.", KB_HOLD_SUSPEND);
+		if (ImGui::CheckboxFlags("Suspend while the map is open", &s_Config.SuspendUiState, EUiState_MapOpen))
+		{
+			SaveSettings();
+		}
+		if (ImGui::CheckboxFlags("Suspend while typing", &s_Config.SuspendUiState, EUiState_TextboxFocused))
+		{
+			SaveSettings();
+		}
+		if (ImGui::CheckboxFlags("Suspend while the game is not focused", &s_Config.SuspendUiState, EUiState_GameUnfocused))
+		{
+			SaveSettings();
+		}
+		if (ImGui::CheckboxFlags("Suspend in competitive modes", &s_Config.SuspendUiState, EUiState_Competitive))
 		{
 			SaveSettings();
 		}
 
 		ImGui::Text("Redirect Input");
-		if (ImGui::Checkbox("Redirect Left-Click while action cam is active", &Config::RedirectLMB))
+		if (ImGui::Checkbox("Redirect Left-Click while action cam is active", &s_Config.RedirectLMB))
 		{
 
 			SaveSettings();
 		}
-		if (Config::RedirectLMB)
+		if (s_Config.RedirectLMB)
 		{
-			ImGui::Text("Left-Click Action:");
-			ImGui::SameLine();
-			GbSelector("##RedirectLMBTarget", &Config::RedirectLMB_Target);
+			RedirectContextOptions(ERedirectButton_LMB, "Left-Click");
+		}
+		if (ImGui::Checkbox("Redirect Right-Click while action cam is active", &s_Config.RedirectRMB))
+		{
+			SaveSettings();
 		}
-		if (ImGui::Checkbox("Redirect Right-Click while action cam is active", &Config::RedirectRMB))
+		if (s_Config.RedirectRMB)
+		{
+			RedirectContextOptions(ERedirectButton_RMB, "Right-Click");
+		}
+
+		if (ImGui::Checkbox("Redirect Left- and Right-Click together while action cam is active", &s_Config.Chord))
 		{
 			SaveSettings();
 		}
-		if (Config::RedirectRMB)
+		if (s_Config.Chord)
 		{
-			ImGui::Text("Right-Click Action:");
+			ImGui::Text("Both Buttons Action:");
 			ImGui::SameLine();
-			GbSelector("##RedirectRMBTarget", &Config::RedirectRMB_Target);
+			GbSelector("##ChordTarget", &s_Config.ChordTarget);
+			ImGui::SliderInt("Max. delay between buttons (ms)", &s_Config.ChordWindowMs, 10, 250);
+			if (ImGui::IsItemDeactivatedAfterEdit())
+			{
+				SaveSettings();
+			}
+		}
+
+		ImGui::Text("Remap Keys");
+		if (ImGui::Checkbox("Remap keys while action cam is active", &s_Config.RemapKeys))
+		{
+			SaveSettings();
+		}
+		if (s_Config.RemapKeys)
+		{
+			KeyRemapOptions();
+		}
+
+		ImGui::Text("Manual Override");
+		ImGui::TooltipGeneric("Pressing your own action cam key pauses the automatic toggling.");
+		ActionCamKeyOptions("Toggle Action Camera key:", &s_Config.ActionCamKey, EKeyCapture_ActionCamKey);
+		ActionCamKeyOptions("Disable Action Camera key:", &s_Config.ActionCamDisableKey, EKeyCapture_ActionCamDisableKey);
+		if (s_Config.ActionCamKey || s_Config.ActionCamDisableKey)
+		{
+			if (ImGui::RadioButton("Resume when conditions change", &s_Config.OverrideExpiry, EOverrideExpiry_OnConditionChange))
+			{
+				SaveSettings();
+			}
+			if (ImGui::RadioButton("Resume after a timeout", &s_Config.OverrideExpiry, EOverrideExpiry_Timeout))
+			{
+				SaveSettings();
+			}
+			if (s_Config.OverrideExpiry == EOverrideExpiry_Timeout)
+			{
+				ImGui::SliderInt("Timeout (s)", &s_Config.OverrideTimeoutSec, 1, 300);
+				if (ImGui::IsItemDeactivatedAfterEdit())
+				{
+					SaveSettings();
+				}
+			}
+			if (ImGui::RadioButton("Resume only when pressing the key again", &s_Config.OverrideExpiry, EOverrideExpiry_Never))
+			{
+				SaveSettings();
+			}
+		}
+
+		ImGui::Text("UI Panels");
+		if (ImGui::Checkbox("Leave action cam when opening a UI panel", &s_Config.ExitOnUiKeys))
+		{
+			SaveSettings();
 		}
+		ImGui::TooltipGeneric("Add the keys you bound in game to e.g. inventory, hero panel, map or trading post.");
+		if (s_Config.ExitOnUiKeys)
+		{
+			UiKeyOptions();
+		}
+
+		DiagnosticsOptions();
 	}
 
-	void LoadSettings()
+	void StartRecording()
 	{
-		std::filesystem::path path = s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/settings.json");
+		/* The trace header takes the settings last applied. */
+		const std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Handler.StartRecording();
+	}
 
-		if (!std::filesystem::exists(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME)))
+	void StopRecording()
+	{
+		std::vector<uint8_t> trace = s_Handler.StopRecording();
+
+		std::ofstream file(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/trace.mlht"), std::ios::binary);
+		file.write((const char*)trace.data(), trace.size());
+	}
+
+	void ReplayTrace()
+	{
+		std::ifstream file(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/trace.mlht"), std::ios::binary);
+		std::vector<uint8_t> trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		std::string replayed;
+		std::string recorded;
+		if (!Trace::Replay(trace, replayed, &recorded))
 		{
-			std::filesystem::create_directory(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME));
+			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, "trace.mlht is missing or malformed.");
+			return;
 		}
 
-		if (!std::filesystem::exists(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/settings.json")))
+		std::ofstream(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/trace.txt")) << replayed;
+		std::ofstream(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/trace_recorded.txt")) << recorded;
+	}
+
+	void ProfilerOptions()
+	{
+		static const char* s_EntryNames[Profiler::EEntry_COUNT] = { "WndProc", "PreRender", "RenderOptions", "LoadSettings", "SaveSettings", "GameBindToString", "GbSelector" };
+
+		for (int entry = 0; entry < Profiler::EEntry_COUNT; entry++)
 		{
-			return;
+			const Profiler::Counters& counters = Profiler::Get((Profiler::EEntry)entry);
+			uint64_t calls   = counters.Calls.load(std::memory_order_relaxed);
+			double   nsPerOp = calls ? counters.Nanoseconds.load(std::memory_order_relaxed) / (double)calls : 0.0;
+
+			if (!Profiler::TracksAllocations)
+			{
+				ImGui::TextDisabled("%s: %llu calls, %.0f ns/op", s_EntryNames[entry], calls, nsPerOp);
+				continue;
+			}
+
+			ImGui::TextDisabled("%s: %llu calls, %.0f ns/op, %.2f allocations/op",
+				s_EntryNames[entry],
+				calls,
+				nsPerOp,
+				calls ? counters.Allocations.load(std::memory_order_relaxed) / (double)calls : 0.0);
+
+			uint64_t violations = counters.Violations.load(std::memory_order_relaxed);
+			if (violations)
+			{
+				ImGui::TextColored(ImVec4(1.f, 1.f, 0.f, 1.f), "%s allocated on %llu calls, it should never allocate.", s_EntryNames[entry], violations);
+			}
+		}
+
+		if (ImGui::Button("Export"))
+		{
+			json results = json::object();
+			results["version"] = { V_MAJOR, V_MINOR, V_BUILD, V_REVISION };
+
+			for (int entry = 0; entry < Profiler::EEntry_COUNT; entry++)
+			{
+				const Profiler::Counters& counters = Profiler::Get((Profiler::EEntry)entry);
+				uint64_t calls = counters.Calls.load(std::memory_order_relaxed);
+
+				json& result = results["entries"][s_EntryNames[entry]];
+				result = {
+					{ "calls",     calls },
+					{ "ns_per_op", calls ? counters.Nanoseconds.load(std::memory_order_relaxed) / (double)calls : 0.0 }
+				};
+
+				if (Profiler::TracksAllocations)
+				{
+					result["allocations_per_op"] = calls ? counters.Allocations.load(std::memory_order_relaxed) / (double)calls : 0.0;
+					result["violations"]         = counters.Violations.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::ofstream(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/profile.json")) << results.dump(1, '\t') << std::endl;
+		}
+		ImGui::TooltipGeneric("Writes profile.json to the addon folder.");
+	}
+
+	void DiagnosticsOptions()
+	{
+		static const char* s_FieldNames[EDataField_COUNT] = { "Combat", "Mount" };
+
+		ImGui::Text("Diagnostics");
+		ImGui::TextDisabled("Cache: %llu invalidations, %llu hits",
+			s_CacheInvalidations.load(std::memory_order_relaxed),
+			s_CacheHits.load(std::memory_order_relaxed));
+		ImGui::TextDisabled(!s_RTAPI.load(std::memory_order_acquire)  ? "RealTime API not loaded, using MumbleLink."
+		                  : s_RtapiFrozenReads >= RTAPI_FROZEN_READS ? "RealTime API stopped updating, using MumbleLink."
+		                  : "RealTime API available.");
+
+		bool profiling = Profiler::IsEnabled();
+		if (ImGui::Checkbox("Measure entry points", &profiling))
+		{
+			Profiler::SetEnabled(profiling);
+		}
+		if (profiling)
+		{
+			ProfilerOptions();
 		}
 
-		json settings = json::object();
+		if (s_Handler.IsRecording())
+		{
+			if (ImGui::Button("Stop recording"))
+			{
+				StopRecording();
+			}
+		}
+		else
+		{
+			if (ImGui::Button("Record trace"))
+			{
+				StartRecording();
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Replay trace"))
+			{
+				ReplayTrace();
+			}
+			ImGui::TooltipGeneric("Records link frames and inputs to trace.mlht in the addon folder.\nReplaying writes the resulting toggles, presses and releases to trace.txt,\nand what happened while recording to trace_recorded.txt.");
+		}
 
-		try
+		for (int field = 0; field < EDataField_COUNT; field++)
 		{
-			std::ifstream file(path);
-			settings = json::parse(file);
-			file.close();
+			uint64_t leads = s_RtapiLeads[field].load(std::memory_order_relaxed);
+			double   leadMs = leads ? s_RtapiLeadTicks[field].load(std::memory_order_relaxed) * 1000.0 / (double)(s_PerformanceCounter.TicksPerSecond() * leads) : 0.0;
+
+			ImGui::TextDisabled("%s: RTAPI %llu / MumbleLink %llu frames, RTAPI ahead %llu times by %.1f ms on average",
+				s_FieldNames[field],
+				s_SourceFrames[field][EDataSource_RTAPI].load(std::memory_order_relaxed),
+				s_SourceFrames[field][EDataSource_MumbleLink].load(std::memory_order_relaxed),
+				leads,
+				leadMs);
 		}
-		catch (json::parse_error& ex)
+	}
+
+	void KeyRemapOptions()
+	{
+		for (int vk = 0; vk < 256; vk++)
 		{
-			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, String::Format("Settings.json could not be parsed. Error: %s", ex.what()).c_str());
+			if (!s_Config.KeyRemap[vk])
+			{
+				continue;
+			}
+
+			ImGui::PushID(vk);
+			ImGui::Text("%s Action:", KeyName(vk));
+			ImGui::SameLine();
+			GbSelector("##KeyRemapTarget", &s_Config.KeyRemapTarget[vk]);
+			ImGui::SameLine();
+			if (ImGui::Button("Remove"))
+			{
+				s_Config.KeyRemap[vk] = false;
+				SaveSettings();
+			}
+			ImGui::PopID();
 		}
-		catch (...)
+
+		int32_t vk = KeyCaptureOptions(EKeyCapture_Remap);
+		if (vk >= 0)
 		{
-			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, "Error reading settings.");
+			s_Config.KeyRemap[vk] = true;
+			SaveSettings();
 		}
+	}
 
-		const std::lock_guard<std::mutex> lock(s_Mutex);
+	void UiKeyOptions()
+	{
+		for (int vk = 0; vk < 256; vk++)
+		{
+			if (!s_Config.UiKey[vk])
+			{
+				continue;
+			}
+
+			ImGui::PushID(vk);
+			ImGui::Text("%s", KeyName(vk));
+			ImGui::SameLine();
+			if (ImGui::Button("Remove"))
+			{
+				s_Config.UiKey[vk] = false;
+				SaveSettings();
+			}
+			ImGui::PopID();
+		}
 
-		if (settings.is_null())
+		int32_t vk = KeyCaptureOptions(EKeyCapture_UiKey);
+		if (vk >= 0)
 		{
-			return;
+			s_Config.UiKey[vk] = true;
+			SaveSettings();
 		}
+	}
+
+	void ActionCamKeyOptions(const char* aLabel, int* aKey, int aOwner)
+	{
+		ImGui::PushID(aOwner);
 
-		if ((!settings["LC_KEY"].is_null() && settings["LC_KEY"].get<int>() > 0) ||
-			(!settings["RC_KEY"].is_null() && settings["RC_KEY"].get<int>() > 0))
+		ImGui::Text("%s", aLabel);
+		ImGui::SameLine();
+		if (*aKey)
 		{
-			/* If the old redirect was being used, show a migration notification. */
-			s_APIDefs->UI.SendAlert("MouseLookHandler has reset your redirected keybinds.\nReview your settings.");
+			ImGui::Text("%s", KeyName(*aKey));
+			ImGui::SameLine();
+			if (ImGui::Button("Clear"))
+			{
+				*aKey = 0;
+				SaveSettings();
+			}
+		}
+		else
+		{
+			int32_t vk = KeyCaptureOptions(aOwner);
+			if (vk > 0)
+			{
+				*aKey = vk;
+				SaveSettings();
+			}
 		}
 
-		Config::ResetToCenter      = settings.value("RESET_CURSOR_CENTER",        false        );
-		Config::EnableWhileMoving  = settings.value("ENABLE_WHILE_MOVING",        true         );
-		Config::EnableInCombat     = settings.value("ENABLE_DURING_COMBAT",       false        );
-		Config::EnableOnMount      = settings.value("ENABLE_ON_MOUNT",            false        );
+		ImGui::PopID();
+	}
+
+	int32_t KeyCaptureOptions(int aOwner)
+	{
+		ImGui::PushID(aOwner);
+
+		int32_t result  = -1;
+		int32_t capture = s_KeyCapture.load();
+
+		if (s_KeyCaptureOwner != aOwner && capture != -1)
+		{
+			/* Another editor is capturing. */
+			ImGui::TextDisabled("Add Key");
+		}
+		else if (capture >= 0)
+		{
+			/* Escape cancels. */
+			if (capture != VK_ESCAPE)
+			{
+				result = capture;
+			}
+			s_KeyCapture.store(-1);
+		}
+		else if (capture == -2)
+		{
+			ImGui::TextDisabled("Press a key, or Escape to cancel...");
+		}
+		else if (ImGui::Button("Add Key"))
+		{
+			s_KeyCaptureOwner = aOwner;
+			s_KeyCapture.store(-2);
+		}
 
-		Config::RedirectLMB        = settings.value("REDIRECT_LEFTCLICK",         false        );
-		Config::RedirectLMB_Target = settings.value("REDIRECT_LEFTCLICK_TARGET",  (EGameBinds)0);
+		ImGui::PopID();
 
-		Config::RedirectRMB        = settings.value("REDIRECT_RIGHTCLICK",        false        );
-		Config::RedirectRMB_Target = settings.value("REDIRECT_RIGHTCLICK_TARGET", (EGameBinds)0);
+		return result;
 	}
 
-	void SaveSettings()
+	void RedirectContextOptions(int aButton, const char* aLabel)
 	{
-		std::filesystem::path path = s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME "/settings.json");
+		static const char* s_ContextLabels[ERedirectContext_COUNT] = { "", "in combat", "while mounted" };
 
-		json settings = json::object();
+		ImGui::PushID(aButton);
 
-		const std::lock_guard<std::mutex> lock(s_Mutex);
+		ImGui::Text("%s Action:", aLabel);
+		ImGui::SameLine();
+		GbSelector("##RedirectTarget", &s_Config.RedirectTarget[ERedirectContext_Default][aButton]);
+
+		for (int ctx = ERedirectContext_Default + 1; ctx < ERedirectContext_COUNT; ctx++)
+		{
+			ImGui::PushID(ctx);
+			if (ImGui::Checkbox("##RedirectOverride", &s_Config.RedirectOverride[ctx][aButton]))
+			{
+				SaveSettings();
+			}
+			ImGui::SameLine();
+			ImGui::Text("%s Action %s:", aLabel, s_ContextLabels[ctx]);
+			if (s_Config.RedirectOverride[ctx][aButton])
+			{
+				ImGui::SameLine();
+				GbSelector("##RedirectTarget", &s_Config.RedirectTarget[ctx][aButton]);
+			}
+			ImGui::PopID();
+		}
+
+		for (int mod = ERedirectModifier_None + 1; mod < ERedirectModifier_COUNT; mod++)
+		{
+			ImGui::PushID(ERedirectContext_COUNT + mod);
+			if (ImGui::Checkbox("##RedirectModifierOverride", &s_Config.RedirectModifierOverride[aButton][mod]))
+			{
+				SaveSettings();
+			}
+			ImGui::SameLine();
+			ImGui::Text("%s+%s Action:", RedirectModifierLabel(mod), aLabel);
+			if (s_Config.RedirectModifierOverride[aButton][mod])
+			{
+				ImGui::SameLine();
+				GbSelector("##RedirectModifierTarget", &s_Config.RedirectModifierTarget[aButton][mod]);
+			}
+			ImGui::PopID();
+		}
+
+		ImGui::PopID();
+	}
 
-		settings["RESET_CURSOR_CENTER"]        = Config::ResetToCenter;
-		settings["ENABLE_WHILE_MOVING"]        = Config::EnableWhileMoving;
-		settings["ENABLE_DURING_COMBAT"]       = Config::EnableInCombat;
-		settings["ENABLE_ON_MOUNT"]            = Config::EnableOnMount;
+	const char* RedirectModifierLabel(int aModifier)
+	{
+		static const char* s_Labels[ERedirectModifier_COUNT] =
+		{
+			"",
+			"Shift",
+			"Ctrl",
+			"Shift+Ctrl",
+			"Alt",
+			"Shift+Alt",
+			"Ctrl+Alt",
+			"Shift+Ctrl+Alt"
+		};
+
+		return s_Labels[aModifier];
+	}
+
+	void LoadSettings()
+	{
+		Profiler::Scope profile(Profiler::EEntry_LoadSettings);
 
-		settings["REDIRECT_LEFTCLICK"]         = Config::RedirectLMB;
-		settings["REDIRECT_LEFTCLICK_TARGET"]  = Config::RedirectLMB_Target;
+		if (!std::filesystem::exists(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME)))
+		{
+			std::filesystem::create_directory(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME));
+		}
 
-		settings["REDIRECT_RIGHTCLICK"]        = Config::RedirectRMB;
-		settings["REDIRECT_RIGHTCLICK_TARGET"] = Config::RedirectRMB_Target;
+		const std::lock_guard<std::mutex> lock(s_Mutex);
 
-		try
+		/* Defaults still have to be applied when there are no settings, e.g. every key starts out not remapped. */
+		std::string error;
+		switch (Core::LoadSettings(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME"/settings.json"), s_Config, &error))
 		{
-			std::ofstream file(path);
-			file << settings.dump(1, '\t') << std::endl;
-			file.close();
+			case Core::ESettings_Malformed:
+			{
+				s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, String::Format("Settings.json could not be parsed. Error: %s", error.c_str()).c_str());
+				break;
+			}
+			case Core::ESettings_Migrated:
+			{
+				/* If the old redirect was being used, show a migration notification. */
+				s_APIDefs->UI.SendAlert("MouseLookHandler has reset your redirected keybinds.\nReview your settings.");
+				break;
+			}
+			default:
+			{
+				break;
+			}
 		}
-		catch (...)
+
+		s_Handler.Apply(s_Config);
+	}
+
+	void SaveSettings()
+	{
+		Profiler::Scope profile(Profiler::EEntry_SaveSettings);
+
+		const std::lock_guard<std::mutex> lock(s_Mutex);
+
+		s_Handler.Apply(s_Config);
+
+		if (!Core::SaveSettings(s_APIDefs->Paths.GetAddonDirectory(ADDON_NAME "/settings.json"), s_Config))
 		{
 			s_APIDefs->Log(ELogLevel_WARNING, ADDON_NAME, "Error writing settings.");
 		}
@@ -11,11 +11,15 @@
 
 #include <windows.h>
 #include <string>
+#include <cstdint>
 
 #include "nexus/Nexus.h"
+#include "Input.h"
 
 #define ADDON_NAME "MouseLookHandler"
 
+#define KB_HOLD_SUSPEND "KB_MLH_HOLD_SUSPEND"
+
 ///----------------------------------------------------------------------------------------------------
 /// GetAddonDef:
 /// 	Returns the addons definitions.
@@ -45,6 +49,30 @@ namespace Addon
 	///----------------------------------------------------------------------------------------------------
 	UINT WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
+	///----------------------------------------------------------------------------------------------------
+	/// ProcessKeybind:
+	/// 	Used to hold action cam suspended.
+	///----------------------------------------------------------------------------------------------------
+	void ProcessKeybind(const char* aIdentifier, bool aIsRelease);
+
+	///----------------------------------------------------------------------------------------------------
+	/// OnWindowResized:
+	/// 	Used to query the client area again.
+	///----------------------------------------------------------------------------------------------------
+	void OnWindowResized(void* aEventArgs);
+
+	///----------------------------------------------------------------------------------------------------
+	/// OnIdentityUpdated:
+	/// 	Used to reset per-character state.
+	///----------------------------------------------------------------------------------------------------
+	void OnIdentityUpdated(void* aEventArgs);
+
+	///----------------------------------------------------------------------------------------------------
+	/// OnAddonsChanged:
+	/// 	Used to look up shared data and bound game binds again.
+	///----------------------------------------------------------------------------------------------------
+	void OnAddonsChanged(void* aEventArgs);
+
 	///----------------------------------------------------------------------------------------------------
 	/// PreRender:
 	/// 	used to detect state changes.
@@ -55,19 +83,13 @@ namespace Addon
 	/// GbSelectable:
 	/// 	Used to render individual game bind elements.
 	///----------------------------------------------------------------------------------------------------
-	void GbSelectable(EGameBinds* aTarget, const char* aLabel, EGameBinds aGameBind);
-
-	///----------------------------------------------------------------------------------------------------
-	/// GameBindToString:
-	/// 	Localizes gamebinds.
-	///----------------------------------------------------------------------------------------------------
-	std::string GameBindToString(EGameBinds aGameBind);
+	void GbSelectable(Input::Bind* aTarget, const char* aLabel, EGameBinds aGameBind);
 
 	///----------------------------------------------------------------------------------------------------
 	/// GbSelector:
 	/// 	Dropdown selector for gamebinds.
 	///----------------------------------------------------------------------------------------------------
-	void GbSelector(const char* aIdentifier, EGameBinds* aTarget);
+	void GbSelector(const char* aIdentifier, Input::Bind* aTarget);
 
 	///----------------------------------------------------------------------------------------------------
 	/// RenderOptions:
@@ -75,6 +97,73 @@ namespace Addon
 	///----------------------------------------------------------------------------------------------------
 	void RenderOptions();
 
+	///----------------------------------------------------------------------------------------------------
+	/// RedirectContextOptions:
+	/// 	Renders the per-context redirect targets of a mouse button.
+	///----------------------------------------------------------------------------------------------------
+	void RedirectContextOptions(int aButton, const char* aLabel);
+
+	///----------------------------------------------------------------------------------------------------
+	/// KeyRemapOptions:
+	/// 	Renders the key remap editor.
+	///----------------------------------------------------------------------------------------------------
+	void KeyRemapOptions();
+
+	///----------------------------------------------------------------------------------------------------
+	/// UiKeyOptions:
+	/// 	Renders the editor for keys that open UI panels.
+	///----------------------------------------------------------------------------------------------------
+	void UiKeyOptions();
+
+	///----------------------------------------------------------------------------------------------------
+	/// StartRecording:
+	/// 	Starts recording a trace of link frames and input messages.
+	///----------------------------------------------------------------------------------------------------
+	void StartRecording();
+
+	///----------------------------------------------------------------------------------------------------
+	/// StopRecording:
+	/// 	Stops recording and writes the trace to the addon directory.
+	///----------------------------------------------------------------------------------------------------
+	void StopRecording();
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReplayTrace:
+	/// 	Replays the recorded trace and writes the resulting output next to it.
+	///----------------------------------------------------------------------------------------------------
+	void ReplayTrace();
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProfilerOptions:
+	/// 	Renders the entry point timings and exports them.
+	///----------------------------------------------------------------------------------------------------
+	void ProfilerOptions();
+
+	///----------------------------------------------------------------------------------------------------
+	/// DiagnosticsOptions:
+	/// 	Renders cache counters, which source served the combat and mount state and how far RTAPI was ahead.
+	///----------------------------------------------------------------------------------------------------
+	void DiagnosticsOptions();
+
+	///----------------------------------------------------------------------------------------------------
+	/// ActionCamKeyOptions:
+	/// 	Renders the selector for one of the player's own action cam keys.
+	///----------------------------------------------------------------------------------------------------
+	void ActionCamKeyOptions(const char* aLabel, int* aKey, int aOwner);
+
+	///----------------------------------------------------------------------------------------------------
+	/// KeyCaptureOptions:
+	/// 	Renders an "Add Key" button which captures the next key press.
+	/// 	Returns the captured virtual-key code once, otherwise -1.
+	///----------------------------------------------------------------------------------------------------
+	int32_t KeyCaptureOptions(int aOwner);
+
+	///----------------------------------------------------------------------------------------------------
+	/// RedirectModifierLabel:
+	/// 	Returns the display name of a modifier combination, e.g. "Shift+Ctrl".
+	///----------------------------------------------------------------------------------------------------
+	const char* RedirectModifierLabel(int aModifier);
+
 	///----------------------------------------------------------------------------------------------------
 	/// LoadSettings:
 	/// 	Loads the user preferences.
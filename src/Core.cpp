@@ -0,0 +1,1098 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Core.cpp
+/// Description  :  Platform independent per-frame and per-message decisions and settings handling.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Core.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+using json = nlohmann::json;
+
+#include "Profiler.h"
+
+namespace Core
+{
+	/* Layout Geometry::UnpackPoint expects, like POINT. */
+	struct Point
+	{
+		int32_t x;
+		int32_t y;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// RedirectSettingsKey:
+	/// 	Returns the settings key of a redirect context and button.
+	///----------------------------------------------------------------------------------------------------
+	static std::string RedirectSettingsKey(int aContext, int aButton)
+	{
+		static const char* s_Buttons[ERedirectButton_COUNT]   = { "REDIRECT_LEFTCLICK", "REDIRECT_RIGHTCLICK" };
+		static const char* s_Contexts[ERedirectContext_COUNT] = { "", "_COMBAT", "_MOUNT" };
+
+		/* Default context keeps the pre-context key names, e.g. REDIRECT_LEFTCLICK_TARGET. */
+		return std::string(s_Buttons[aButton]) + s_Contexts[aContext];
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// RedirectModifierSettingsKey:
+	/// 	Returns the settings key of a redirect button and modifier combination.
+	///----------------------------------------------------------------------------------------------------
+	static std::string RedirectModifierSettingsKey(int aButton, int aModifier)
+	{
+		static const char* s_Buttons[ERedirectButton_COUNT]     = { "REDIRECT_LEFTCLICK", "REDIRECT_RIGHTCLICK" };
+		static const char* s_Modifiers[ERedirectModifier_COUNT] =
+		{
+			"",
+			"_SHIFT",
+			"_CTRL",
+			"_SHIFT_CTRL",
+			"_ALT",
+			"_SHIFT_ALT",
+			"_CTRL_ALT",
+			"_SHIFT_CTRL_ALT"
+		};
+
+		return std::string(s_Buttons[aButton]) + s_Modifiers[aModifier];
+	}
+
+	std::string SerializeSettings(const Config& aConfig)
+	{
+		json settings = json::object();
+
+		settings["RESET_CURSOR_CENTER"]        = aConfig.ResetToCenter;
+		settings["RESTORE_CURSOR_POSITION"]    = aConfig.RestoreCursor;
+		settings["ENABLE_WHILE_MOVING"]        = aConfig.EnableWhileMoving;
+		settings["ENABLE_DURING_COMBAT"]       = aConfig.EnableInCombat;
+		settings["ENABLE_ON_MOUNT"]            = aConfig.EnableOnMount;
+		settings["ENABLE_WHEN_ZOOMED_IN"]      = aConfig.EnableWhenZoomedIn;
+		settings["ZOOM_IN_DISTANCE"]           = aConfig.ZoomInDistance;
+		settings["ZOOM_OUT_DISTANCE"]          = aConfig.ZoomOutDistance;
+
+		settings["SUSPEND_UI_STATE"]           = aConfig.SuspendUiState;
+
+		settings["REDIRECT_LEFTCLICK"]         = aConfig.RedirectLMB;
+		settings["REDIRECT_RIGHTCLICK"]        = aConfig.RedirectRMB;
+
+		for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+		{
+			for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+			{
+				std::string key = RedirectSettingsKey(ctx, btn);
+
+				settings[key + "_TARGET"] = aConfig.RedirectTarget[ctx][btn];
+				if (ctx != ERedirectContext_Default)
+				{
+					settings[key] = aConfig.RedirectOverride[ctx][btn];
+				}
+			}
+		}
+
+		for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+		{
+			for (int mod = ERedirectModifier_None + 1; mod < ERedirectModifier_COUNT; mod++)
+			{
+				std::string key = RedirectModifierSettingsKey(btn, mod);
+
+				settings[key + "_TARGET"] = aConfig.RedirectModifierTarget[btn][mod];
+				settings[key]             = aConfig.RedirectModifierOverride[btn][mod];
+			}
+		}
+
+		settings["CHORD"]                      = aConfig.Chord;
+		settings["CHORD_TARGET"]               = aConfig.ChordTarget;
+		settings["CHORD_WINDOW_MS"]            = aConfig.ChordWindowMs;
+
+		settings["REMAP_KEYS"]                 = aConfig.RemapKeys;
+
+		json remaps = json::array();
+		for (int vk = 0; vk < 256; vk++)
+		{
+			if (aConfig.KeyRemap[vk])
+			{
+				remaps.push_back({ { "VK", vk }, { "TARGET", aConfig.KeyRemapTarget[vk] } });
+			}
+		}
+		settings["KEY_REMAPS"]                 = remaps;
+
+		settings["ACTIONCAM_KEY"]              = aConfig.ActionCamKey;
+		settings["ACTIONCAM_DISABLE_KEY"]      = aConfig.ActionCamDisableKey;
+		settings["OVERRIDE_EXPIRY"]            = aConfig.OverrideExpiry;
+		settings["OVERRIDE_TIMEOUT_SEC"]       = aConfig.OverrideTimeoutSec;
+
+		settings["EXIT_ON_UI_KEYS"]            = aConfig.ExitOnUiKeys;
+
+		json uiKeys = json::array();
+		for (int vk = 0; vk < 256; vk++)
+		{
+			if (aConfig.UiKey[vk])
+			{
+				uiKeys.push_back(vk);
+			}
+		}
+		settings["UI_KEYS"]                    = uiKeys;
+
+		return settings.dump(1, '\t');
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadSettings:
+	/// 	Fills a config from parsed settings, missing keys keep the defaults. Throws json::type_error
+	/// 	on values of the wrong type.
+	///----------------------------------------------------------------------------------------------------
+	static void ReadSettings(const json& aSettings, Config& aConfig)
+	{
+		const Config defaults{};
+
+		aConfig.ResetToCenter      = aSettings.value("RESET_CURSOR_CENTER",        defaults.ResetToCenter     );
+		aConfig.RestoreCursor      = aSettings.value("RESTORE_CURSOR_POSITION",    defaults.RestoreCursor     ) && !aConfig.ResetToCenter;
+		aConfig.EnableWhileMoving  = aSettings.value("ENABLE_WHILE_MOVING",        defaults.EnableWhileMoving );
+		aConfig.EnableInCombat     = aSettings.value("ENABLE_DURING_COMBAT",       defaults.EnableInCombat    );
+		aConfig.EnableOnMount      = aSettings.value("ENABLE_ON_MOUNT",            defaults.EnableOnMount     );
+		aConfig.EnableWhenZoomedIn = aSettings.value("ENABLE_WHEN_ZOOMED_IN",      defaults.EnableWhenZoomedIn);
+		aConfig.ZoomInDistance     = aSettings.value("ZOOM_IN_DISTANCE",           defaults.ZoomInDistance    );
+		aConfig.ZoomOutDistance    = aSettings.value("ZOOM_OUT_DISTANCE",          defaults.ZoomOutDistance   );
+
+		aConfig.SuspendUiState     = aSettings.value("SUSPEND_UI_STATE",           defaults.SuspendUiState    );
+
+		aConfig.RedirectLMB        = aSettings.value("REDIRECT_LEFTCLICK",         defaults.RedirectLMB       );
+		aConfig.RedirectRMB        = aSettings.value("REDIRECT_RIGHTCLICK",        defaults.RedirectRMB       );
+
+		for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+		{
+			for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+			{
+				std::string key = RedirectSettingsKey(ctx, btn);
+
+				aConfig.RedirectTarget[ctx][btn]   = aSettings.value(key + "_TARGET", (Input::Bind)0);
+				aConfig.RedirectOverride[ctx][btn] = ctx == ERedirectContext_Default || aSettings.value(key, false);
+			}
+		}
+
+		for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+		{
+			for (int mod = ERedirectModifier_None + 1; mod < ERedirectModifier_COUNT; mod++)
+			{
+				std::string key = RedirectModifierSettingsKey(btn, mod);
+
+				aConfig.RedirectModifierTarget[btn][mod]   = aSettings.value(key + "_TARGET", (Input::Bind)0);
+				aConfig.RedirectModifierOverride[btn][mod] = aSettings.value(key, false);
+			}
+		}
+
+		aConfig.Chord              = aSettings.value("CHORD",                      defaults.Chord             );
+		aConfig.ChordTarget        = aSettings.value("CHORD_TARGET",               defaults.ChordTarget       );
+		aConfig.ChordWindowMs      = aSettings.value("CHORD_WINDOW_MS",            defaults.ChordWindowMs     );
+
+		aConfig.RemapKeys          = aSettings.value("REMAP_KEYS",                 defaults.RemapKeys         );
+
+		std::fill(std::begin(aConfig.KeyRemap), std::end(aConfig.KeyRemap), false);
+		if (aSettings.contains("KEY_REMAPS") && aSettings["KEY_REMAPS"].is_array())
+		{
+			for (const json& remap : aSettings["KEY_REMAPS"])
+			{
+				int vk = remap.value("VK", -1);
+
+				if (vk < 0 || vk > 255)
+				{
+					continue;
+				}
+
+				aConfig.KeyRemap[vk]       = true;
+				aConfig.KeyRemapTarget[vk] = remap.value("TARGET", (Input::Bind)0);
+			}
+		}
+
+		aConfig.ActionCamKey        = aSettings.value("ACTIONCAM_KEY",             defaults.ActionCamKey       );
+		aConfig.ActionCamDisableKey = aSettings.value("ACTIONCAM_DISABLE_KEY",     defaults.ActionCamDisableKey);
+		aConfig.OverrideExpiry      = aSettings.value("OVERRIDE_EXPIRY",           defaults.OverrideExpiry     );
+		aConfig.OverrideTimeoutSec  = aSettings.value("OVERRIDE_TIMEOUT_SEC",      defaults.OverrideTimeoutSec );
+
+		aConfig.ExitOnUiKeys       = aSettings.value("EXIT_ON_UI_KEYS",            defaults.ExitOnUiKeys      );
+
+		std::fill(std::begin(aConfig.UiKey), std::end(aConfig.UiKey), false);
+		if (aSettings.contains("UI_KEYS") && aSettings["UI_KEYS"].is_array())
+		{
+			for (const json& key : aSettings["UI_KEYS"])
+			{
+				int vk = key.is_number_integer() ? key.get<int>() : -1;
+
+				if (vk < 0 || vk > 255)
+				{
+					continue;
+				}
+
+				aConfig.UiKey[vk] = true;
+			}
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsMigrated:
+	/// 	Returns whether the pre-context redirects were in use, they were reset along with their keys.
+	///----------------------------------------------------------------------------------------------------
+	static bool IsMigrated(const json& aSettings)
+	{
+		for (const char* key : { "LC_KEY", "RC_KEY" })
+		{
+			if (aSettings.contains(key) && aSettings[key].is_number_integer() && aSettings[key].get<int>() > 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	ESettings DeserializeSettings(const std::string& aText, Config& aConfig, std::string* aError)
+	{
+		try
+		{
+			json settings = json::parse(aText);
+
+			if (settings.is_object())
+			{
+				ReadSettings(settings, aConfig);
+				return IsMigrated(settings) ? ESettings_Migrated : ESettings_Loaded;
+			}
+
+			if (aError)
+			{
+				*aError = "settings are not an object";
+			}
+		}
+		catch (json::exception& ex)
+		{
+			if (aError)
+			{
+				*aError = ex.what();
+			}
+		}
+
+		aConfig = Config{};
+		return ESettings_Malformed;
+	}
+
+	ESettings LoadSettings(const std::filesystem::path& aPath, Config& aConfig, std::string* aError)
+	{
+		std::ifstream file(aPath);
+		if (!file)
+		{
+			return ESettings_Missing;
+		}
+
+		std::stringstream text;
+		text << file.rdbuf();
+
+		return DeserializeSettings(text.str(), aConfig, aError);
+	}
+
+	bool SaveSettings(const std::filesystem::path& aPath, const Config& aConfig)
+	{
+		std::ofstream file(aPath);
+		file << SerializeSettings(aConfig) << std::endl;
+		return (bool)file;
+	}
+
+	void Handler::TracingOutput::Press(Input::Bind aBind)
+	{
+		Owner.Game.Press(aBind);
+		Owner.TraceEvent(Trace::ERecord_Press, aBind);
+	}
+
+	void Handler::TracingOutput::Release(Input::Bind aBind)
+	{
+		Owner.Game.Release(aBind);
+		Owner.TraceEvent(Trace::ERecord_Release, aBind);
+	}
+
+	void Handler::TracingOutput::ButtonUp(uint32_t aMsg, uint64_t aWParam, int64_t aLParam)
+	{
+		Owner.Game.ButtonUp(aMsg, aWParam, aLParam);
+		Owner.TraceEvent(Trace::ERecord_ButtonUp, aMsg);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Evaluate:
+	/// 	Returns whether action cam should be active. Instantiated per combination of EActivationFlags,
+	/// 	so the per-frame path does not branch on the config.
+	///----------------------------------------------------------------------------------------------------
+	template <uint32_t Flags>
+	bool Handler::Evaluate(Handler& aHandler, const Snapshot& aLink)
+	{
+		bool cursorHidden = aLink.IsCursorHidden;
+
+		/* Usually already handled by Process on the first message after the cursor reappeared. */
+		bool reappeared = aHandler.CursorReappeared(cursorHidden, aLink.IsCameraMoving);
+
+		if constexpr ((Flags & EActivation_ResetToCenter) != 0)
+		{
+			if (reappeared)
+			{
+				aHandler.ResetCursor(ECursorReset_Center, Trace::EResetFrom_Frame);
+			}
+		}
+
+		if constexpr ((Flags & EActivation_RestoreCursor) != 0)
+		{
+			if (reappeared)
+			{
+				aHandler.ResetCursor(ECursorReset_Restore, Trace::EResetFrom_Frame);
+			}
+			else if (!cursorHidden)
+			{
+				/* Keep tracking until the cursor hides, the game may already have moved it on the hiding frame. */
+				aHandler.TrackCursorPosition();
+			}
+		}
+
+		Activation::Conditions conditions{};
+		conditions.IsMoving   = aLink.IsMoving;
+		conditions.InCombat   = (aLink.UiState & EUiState_InCombat) != 0;
+		conditions.IsMounted  = aLink.MountIndex != 0;
+		conditions.IsZoomedIn = aLink.IsZoomedIn;
+
+		return Activation::ShouldActivate<Flags>(conditions);
+	}
+
+	template <size_t... Flags>
+	constexpr std::array<Handler::Evaluator, sizeof...(Flags)> Handler::MakeEvaluators(std::index_sequence<Flags...>)
+	{
+		return { &Evaluate<Flags>... };
+	}
+
+	const std::array<Handler::Evaluator, EActivation_COUNT> Handler::Evaluators = MakeEvaluators(std::make_index_sequence<EActivation_COUNT>{});
+
+	Handler::Handler(GameProvider& aGame, CursorProvider& aCursor, WindowProvider& aWindow, LinkProvider& aLink, ClockProvider& aClock)
+		: Game(aGame)
+		, Cursor(aCursor)
+		, Window(aWindow)
+		, Link(aLink)
+		, Clock(aClock)
+		, TicksPerSecond(aClock.TicksPerSecond())
+		, ActiveEvaluator(Evaluators[EActivation_WhileMoving])
+	{
+	}
+
+	void Handler::Start(MouseLookHandler::SharedState* aShared, MouseLookHandler::InhibitChannel* aInhibit)
+	{
+		Shared  = aShared;
+		Inhibit = aInhibit;
+
+		ClientRect.store(Geometry::Pack(Window.QueryClientRect()), std::memory_order_release);
+	}
+
+	void Handler::Stop()
+	{
+		/* No more messages or frames, nothing releases the binds still held down or undoes the addon's action cam. */
+		Router.ReleaseAll(Output);
+
+		if (TakeBackActive() && Router.IsActionCam())
+		{
+			ToggleActionCam(true);
+		}
+
+		PublishState(false, ERedirectContext_Default, MouseLookHandler::ESuspend_Unloaded);
+		Shared = nullptr;
+	}
+
+	void Handler::Apply(const Config& aConfig)
+	{
+		uint32_t activation = (aConfig.ResetToCenter      ? (uint32_t)EActivation_ResetToCenter : 0)
+		                    | (aConfig.RestoreCursor      ? (uint32_t)EActivation_RestoreCursor : 0)
+		                    | (aConfig.EnableWhileMoving  ? (uint32_t)EActivation_WhileMoving : 0)
+		                    | (aConfig.EnableInCombat     ? (uint32_t)EActivation_InCombat : 0)
+		                    | (aConfig.EnableOnMount      ? (uint32_t)EActivation_OnMount : 0)
+		                    | (aConfig.EnableWhenZoomedIn ? (uint32_t)EActivation_ZoomedIn : 0);
+		ActiveEvaluator.store(Evaluators[activation], std::memory_order_release);
+
+		SuspendUiState.store(aConfig.SuspendUiState, std::memory_order_relaxed);
+
+		float zoomOut = std::max(aConfig.ZoomInDistance, aConfig.ZoomOutDistance);
+		ZoomInDistanceSq.store(aConfig.ZoomInDistance * aConfig.ZoomInDistance, std::memory_order_relaxed);
+		ZoomOutDistanceSq.store(zoomOut * zoomOut, std::memory_order_relaxed);
+
+		CursorReset.store(aConfig.ResetToCenter ? ECursorReset_Center
+		                : aConfig.RestoreCursor ? ECursorReset_Restore
+		                : ECursorReset_None, std::memory_order_release);
+
+		Input::Settings& input = InputSettings;
+		input.Redirect[ERedirectButton_LMB] = aConfig.RedirectLMB;
+		input.Redirect[ERedirectButton_RMB] = aConfig.RedirectRMB;
+		std::copy(&aConfig.RedirectOverride[0][0], &aConfig.RedirectOverride[0][0] + ERedirectContext_COUNT * ERedirectButton_COUNT, &input.RedirectOverride[0][0]);
+		std::copy(&aConfig.RedirectTarget[0][0], &aConfig.RedirectTarget[0][0] + ERedirectContext_COUNT * ERedirectButton_COUNT, &input.RedirectTarget[0][0]);
+		std::copy(&aConfig.RedirectModifierOverride[0][0], &aConfig.RedirectModifierOverride[0][0] + ERedirectButton_COUNT * ERedirectModifier_COUNT, &input.RedirectModifierOverride[0][0]);
+		std::copy(&aConfig.RedirectModifierTarget[0][0], &aConfig.RedirectModifierTarget[0][0] + ERedirectButton_COUNT * ERedirectModifier_COUNT, &input.RedirectModifierTarget[0][0]);
+		input.Chord         = aConfig.Chord;
+		input.ChordTarget   = aConfig.ChordTarget;
+		input.ChordWindowMs = aConfig.ChordWindowMs;
+		input.RemapKeys     = aConfig.RemapKeys;
+		std::copy(std::begin(aConfig.KeyRemap), std::end(aConfig.KeyRemap), input.KeyRemap);
+		std::copy(std::begin(aConfig.KeyRemapTarget), std::end(aConfig.KeyRemapTarget), input.KeyRemapTarget);
+		input.ExitOnUiKeys  = aConfig.ExitOnUiKeys;
+		std::copy(std::begin(aConfig.UiKey), std::end(aConfig.UiKey), input.UiKey);
+		input.ActionCamKey        = aConfig.ActionCamKey;
+		input.ActionCamDisableKey = aConfig.ActionCamDisableKey;
+		Router.Apply(input, TicksPerSecond);
+
+		ActivationRules.OverrideExpiry  = aConfig.OverrideExpiry;
+		OverrideExpiry.store(aConfig.OverrideExpiry, std::memory_order_relaxed);
+		ActivationRules.OverrideTimeout = TicksPerSecond * aConfig.OverrideTimeoutSec;
+		ActivationRules.ToggleLatency   = TicksPerSecond / 4;
+	}
+
+	void Handler::Frame(bool aWantsMouse, bool aWantsKeyboard)
+	{
+		/* Loaded before anything else, a UI key press from here on takes the toggle decision away from this frame. */
+		uint32_t active = Active.load(std::memory_order_acquire);
+
+		Router.SetWantsMouse(aWantsMouse);
+
+		const Snapshot link = TakeSnapshot();
+
+		bool typing = (link.UiState & EUiState_TextboxFocused) || aWantsKeyboard;
+		Typing.store(typing, std::memory_order_relaxed);
+		KeysSuspended.store(typing || !link.IsGameplay || (link.UiState & SuspendUiState.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+
+		bool dragging = Router.IsDragging();
+
+		/* The cursor hides for action cam and for click or camera drags alike. Drags are told apart by a button
+		 * going down on a visible cursor. NexusLink's IsCameraMoving does not help, it is set for both, and
+		 * neither does counting the addon's own toggles, the game drops action cam on its own and ignores
+		 * toggles e.g. while a panel is opening. */
+		//                ui is ticking   && cursor not visible   && not hidden by a click or camera drag
+		bool actionCam = link.IsGameplay && link.IsCursorHidden && !dragging;
+		Router.SetActionCam(actionCam);
+
+		int64_t          now     = Clock.Now();
+		ERedirectContext context = ERedirectContext_Default;
+		uint32_t         suspend = EvaluateState(link, actionCam, dragging, now, active, context);
+
+		PublishState(actionCam, context, suspend);
+
+		if (Recording.load(std::memory_order_relaxed))
+		{
+			TraceFrame(link, actionCam, dragging, aWantsMouse, now, suspend);
+		}
+	}
+
+	bool Handler::Process(Input::Message aMessage)
+	{
+		switch (aMessage.Msg)
+		{
+			case Input::EMessage_LButtonDblClk:
+			case Input::EMessage_LButtonDown:
+			case Input::EMessage_RButtonDblClk:
+			case Input::EMessage_RButtonDown:
+			{
+				aMessage.Now          = Clock.Now();
+				aMessage.CursorHidden = Cursor.IsHidden();
+				aMessage.Inhibited    = Inhibit && Inhibit->Inhibit.load(std::memory_order_acquire);
+				break;
+			}
+		}
+
+		TraceMessage(aMessage);
+
+		if (ClientRectStale.load(std::memory_order_relaxed) && ClientRectStale.exchange(false, std::memory_order_acq_rel))
+		{
+			ClientRect.store(Geometry::Pack(Window.QueryClientRect()), std::memory_order_release);
+		}
+
+		switch (aMessage.Msg)
+		{
+			case Input::EMessage_SetCursor:
+			case Input::EMessage_MouseMove:
+			{
+				/* Drops buttons whose up was missed before the cursor is looked at, mouse moves carry the MK_ flags. */
+				if (aMessage.Msg == Input::EMessage_MouseMove)
+				{
+					Router.Process(aMessage, Output);
+				}
+
+				/* Reset the cursor on the first message after it reappears, not a frame later in Frame. */
+				uint32_t reset = CursorReset.load(std::memory_order_acquire);
+				if (reset != ECursorReset_None && CursorReappeared(Cursor.IsHidden(), Link.IsCameraMoving()))
+				{
+					ResetCursor(reset, Trace::EResetFrom_Message);
+				}
+				return false;
+			}
+			case Input::EMessage_Move:
+			case Input::EMessage_Size:
+			case Input::EMessage_DpiChanged:
+			case Input::EMessage_DisplayChange:
+			{
+				UpdateClientRect(aMessage.Msg, aMessage.LParam);
+				return false;
+			}
+			case Input::EMessage_KeyDown:
+			case Input::EMessage_SysKeyDown:
+			{
+				ManualOverridePress(aMessage.WParam, aMessage.LParam);
+				UiKeyPress(aMessage.WParam, aMessage.LParam);
+				break;
+			}
+		}
+
+		return Router.Process(aMessage, Output);
+	}
+
+	void Handler::SetHoldSuspended(bool aHeld)
+	{
+		HoldSuspended.store(aHeld, std::memory_order_release);
+	}
+
+	void Handler::InvalidateClientRect()
+	{
+		ClientRectStale.store(true, std::memory_order_release);
+	}
+
+	void Handler::ResetIdentity()
+	{
+		IdentityStale.store(true, std::memory_order_release);
+	}
+
+	void Handler::StartRecording()
+	{
+		Activation::State state{};
+		state.WasActive         = (Active.load(std::memory_order_acquire) & 1) != 0;
+		state.Override          = Override.load(std::memory_order_acquire);
+		state.OverrideCondition = OverrideCondition.load(std::memory_order_relaxed);
+		state.OverrideSince     = OverrideSince.load(std::memory_order_relaxed);
+		state.ToggledAt         = ToggledAt.load(std::memory_order_relaxed);
+
+		const std::lock_guard<std::mutex> lock(TraceMutex);
+		TraceWriter.Begin(TicksPerSecond, ActivationRules, state, InputSettings, SuspendUiState.load(std::memory_order_relaxed), Clock.Now());
+		Recording.store(true, std::memory_order_relaxed);
+	}
+
+	std::vector<uint8_t> Handler::StopRecording()
+	{
+		Recording.store(false, std::memory_order_relaxed);
+
+		std::vector<uint8_t> trace;
+		const std::lock_guard<std::mutex> lock(TraceMutex);
+		trace.swap(TraceWriter.Buffer);
+		return trace;
+	}
+
+	bool Handler::IsRecording() const
+	{
+		return Recording.load(std::memory_order_relaxed);
+	}
+
+	bool Handler::IsActive() const
+	{
+		return (Active.load(std::memory_order_acquire) & 1) != 0;
+	}
+
+	const Input::Router& Handler::GetRouter() const
+	{
+		return Router;
+	}
+
+	Geometry::ClientRect Handler::GetClientRect() const
+	{
+		return Geometry::Unpack(ClientRect.load(std::memory_order_acquire));
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TakeSnapshot:
+	/// 	Reads the link data and cursor visibility and updates the zoom state.
+	///----------------------------------------------------------------------------------------------------
+	Handler::Snapshot Handler::TakeSnapshot()
+	{
+		/* New character or map, state carried between frames no longer applies. */
+		if (IdentityStale.load(std::memory_order_relaxed) && IdentityStale.exchange(false, std::memory_order_acq_rel))
+		{
+			ZoomedIn = false;
+		}
+
+		Snapshot snapshot{};
+		Link.Read(snapshot);
+		snapshot.IsCursorHidden = Cursor.IsHidden();
+
+		ZoomedIn = ZoomedIn
+			? snapshot.CameraDistanceSq <= ZoomOutDistanceSq.load(std::memory_order_relaxed)
+			: snapshot.CameraDistanceSq <  ZoomInDistanceSq.load(std::memory_order_relaxed);
+
+		snapshot.IsZoomedIn = ZoomedIn;
+
+		return snapshot;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// EvaluateState:
+	/// 	Selects the redirect context and toggles action cam as needed. Returns the ESuspend reasons.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t Handler::EvaluateState(const Snapshot& aLink, bool aActionCam, bool aDragging, int64_t aNow, uint32_t aActive, ERedirectContext& aContext)
+	{
+		/* Do not evaluate state changes while not in gameplay. */
+		if (!aLink.IsGameplay)
+		{
+			return MouseLookHandler::ESuspend_NotGameplay;
+		}
+
+		/* Do not evaluate state changes or redirect while e.g. the map is open or chat is focused. */
+		if (aLink.UiState & SuspendUiState.load(std::memory_order_relaxed))
+		{
+			Router.Suspend();
+			return MouseLookHandler::ESuspend_UiState;
+		}
+
+		/* Mounted takes precedence over combat, e.g. warclaw in WvW. */
+		if (aLink.MountIndex != 0)
+		{
+			aContext = ERedirectContext_Mount;
+		}
+		else if (aLink.UiState & EUiState_InCombat)
+		{
+			aContext = ERedirectContext_Combat;
+		}
+
+		bool     shouldActivate = ActiveEvaluator.load(std::memory_order_acquire)(*this, aLink);
+		uint32_t suspend        = MouseLookHandler::ESuspend_None;
+
+		/* A UI panel was opened from Process, which already dropped action cam. Panels may be closed without
+		 * their keys, so the block also ends once the conditions do. Decided before hold and inhibit, which
+		 * only pause the conditions. */
+		if (UiKeySuspended.load(std::memory_order_acquire))
+		{
+			if (!shouldActivate)
+			{
+				Router.ClosePanels();
+				UiKeySuspended.store(false, std::memory_order_release);
+			}
+			shouldActivate = false;
+			suspend |= MouseLookHandler::ESuspend_UiKey;
+		}
+
+		/* Like holding the suspend key, but also stops redirecting keys and clicks. */
+		if (Inhibit && Inhibit->Inhibit.load(std::memory_order_acquire))
+		{
+			shouldActivate = false;
+			suspend |= MouseLookHandler::ESuspend_Inhibit;
+			Router.Suspend();
+		}
+		else
+		{
+			Router.SetContext(aContext);
+		}
+
+		/* Held down: drops action cam if the addon turned it on. Released: reactivates within the same frame. */
+		if (HoldSuspended.load(std::memory_order_acquire))
+		{
+			shouldActivate = false;
+			suspend |= MouseLookHandler::ESuspend_Hold;
+		}
+
+		ShouldActivate.store(shouldActivate, std::memory_order_relaxed);
+
+		/* While the camera is dragged by hand the cursor says nothing about action cam, do not toggle. */
+		if (aDragging)
+		{
+			return suspend | MouseLookHandler::ESuspend_Dragging;
+		}
+
+		uint32_t override  = Override.load(std::memory_order_acquire);
+		bool     wasActive = (aActive & 1) != 0;
+
+		Activation::State state{};
+		state.WasActive         = wasActive;
+		state.Override          = override;
+		state.OverrideCondition = OverrideCondition.load(std::memory_order_relaxed);
+		state.OverrideSince     = OverrideSince.load(std::memory_order_relaxed);
+		state.ToggledAt         = ToggledAt.load(std::memory_order_relaxed);
+
+		Activation::Frame frame{};
+		frame.CursorControlled = aActionCam;
+		frame.ShouldActivate   = shouldActivate;
+		frame.Now              = aNow;
+
+		Activation::EStep step = Activation::Step(state, frame, ActivationRules);
+
+		if (step == Activation::EStep_Overridden)
+		{
+			return suspend | MouseLookHandler::ESuspend_ManualOverride;
+		}
+
+		/* Expired, unless Process started a new override in the meantime. */
+		if (state.Override != override)
+		{
+			Override.compare_exchange_strong(override, state.Override, std::memory_order_acq_rel);
+		}
+
+		/* Committed before toggling. If Process took action cam back for a UI panel since the frame started, it
+		 * already toggled and this frame decided on stale state, so neither its toggle nor its flag apply. */
+		if (step == Activation::EStep_Toggle || state.WasActive != wasActive)
+		{
+			uint32_t next = (aActive & ~1u) | (state.WasActive ? 1u : 0u);
+			if (!Active.compare_exchange_strong(aActive, next, std::memory_order_acq_rel))
+			{
+				return suspend;
+			}
+		}
+
+		if (step == Activation::EStep_Toggle)
+		{
+			ToggledAt.store(state.ToggledAt, std::memory_order_relaxed);
+			ToggleActionCam(false);
+		}
+
+		return suspend;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// PublishState:
+	/// 	Writes the shared state for other addons under the seqlock.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::PublishState(bool aActionCam, ERedirectContext aContext, uint32_t aSuspend)
+	{
+		if (!Shared)
+		{
+			return;
+		}
+
+		MouseLookHandler::Write(Shared, aActionCam, (MouseLookHandler::EProfile)aContext, aSuspend);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ToggleActionCam:
+	/// 	Toggles action cam on behalf of the addon, so Process does not mistake the injected key for
+	/// 	a manual override.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::ToggleActionCam(bool aImmediate)
+	{
+		SelfToggles.fetch_add(1);
+		SelfToggleExpiry.store(Clock.Now() + TicksPerSecond / 4, std::memory_order_release);
+
+		Game.ToggleActionCam(aImmediate);
+
+		TraceEvent(Trace::ERecord_Toggle);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TakeBackActive:
+	/// 	Clears that the addon turned action cam on, so the caller undoes it instead of Frame. Returns
+	/// 	whether it was set.
+	///----------------------------------------------------------------------------------------------------
+	bool Handler::TakeBackActive()
+	{
+		uint32_t active = Active.load(std::memory_order_acquire);
+		do
+		{
+			if ((active & 1) == 0)
+			{
+				return false;
+			}
+		} while (!Active.compare_exchange_weak(active, (active + 2) & ~1u, std::memory_order_acq_rel));
+
+		return true;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ManualOverridePress:
+	/// 	Detects the player pressing their own action cam keys.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::ManualOverridePress(uint64_t aWParam, int64_t aLParam)
+	{
+		int vk = (int)(aWParam & 0xFF);
+
+		/* Bit 30: previous key state, set on autorepeat. */
+		if (vk == 0 || (aLParam & (1 << 30)))
+		{
+			return;
+		}
+
+		EOverride override;
+		int actionCamKey = Router.GetActionCamKey();
+
+		if (vk == actionCamKey)
+		{
+			override = Router.IsActionCam() ? EOverride_ManualOff : EOverride_ManualOn;
+		}
+		else if (vk == Router.GetActionCamDisableKey())
+		{
+			override = EOverride_ManualOff;
+		}
+		else
+		{
+			return;
+		}
+
+		int64_t now = Clock.Now();
+
+		/* Our own toggles come through here as well. */
+		uint32_t selfToggles = SelfToggles.load();
+		while (selfToggles > 0 && vk == actionCamKey)
+		{
+			if (now > SelfToggleExpiry.load(std::memory_order_acquire))
+			{
+				SelfToggles.store(0);
+				break;
+			}
+			if (SelfToggles.compare_exchange_weak(selfToggles, selfToggles - 1))
+			{
+				return;
+			}
+		}
+
+		/* Ignored where the activation conditions are not evaluated either. */
+		if (KeysSuspended.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		bool condition = ShouldActivate.load(std::memory_order_relaxed);
+		OverrideSince.store(now, std::memory_order_relaxed);
+		OverrideCondition.store(condition, std::memory_order_relaxed);
+
+		/* Frame may expire the current override concurrently. */
+		int      expiry  = OverrideExpiry.load(std::memory_order_relaxed);
+		uint32_t current = Override.load(std::memory_order_acquire);
+		uint32_t next;
+		do
+		{
+			next = Activation::OverrideForPress(current, override, expiry);
+		} while (!Override.compare_exchange_weak(current, next, std::memory_order_acq_rel));
+
+		TraceEvent(Trace::ERecord_Override, next | (condition << 8));
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// UiKeyPress:
+	/// 	Leaves action cam before the game opens a UI panel, instead of fighting it for the cursor.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::UiKeyPress(uint64_t aWParam, int64_t aLParam)
+	{
+		uint32_t vk = aWParam & 0xFF;
+
+		/* Bit 30: previous key state, set on autorepeat. */
+		if (aLParam & (1 << 30))
+		{
+			return;
+		}
+
+		/* Typed text, e.g. an I in chat does not open the inventory. */
+		if (Typing.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		if (Router.IsUiKey(vk))
+		{
+			/* Pressing the key of an open panel closes it again. */
+			bool opened = Router.TogglePanel(vk);
+			UiKeySuspended.store(Router.IsPanelOpen(), std::memory_order_release);
+
+			/* Still tracked while suspended, but the addon is not in charge of action cam then. */
+			if (!opened || KeysSuspended.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			/* Only drop action cam if the addon turned it on, the game handles manual action cam itself. */
+			if (TakeBackActive())
+			{
+				TraceEvent(Trace::ERecord_ClearActive);
+
+				/* Toggled before the key is passed on, so the game opens the panel without action cam. */
+				if (Router.IsActionCam())
+				{
+					ToggleActionCam(true);
+				}
+			}
+		}
+		else if (vk == 0x1B /* VK_ESCAPE */)
+		{
+			/* Escape closes the panels again. */
+			Router.ClosePanels();
+			UiKeySuspended.store(false, std::memory_order_release);
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// CursorReappeared:
+	/// 	Records the cursor visibility and returns true exactly once per hidden-to-visible transition
+	/// 	caused by the camera, regardless of whether Frame or Process observes it first. The end of
+	/// 	a click or camera drag does not count.
+	///----------------------------------------------------------------------------------------------------
+	bool Handler::CursorReappeared(bool aCursorHidden, bool aCameraMoving)
+	{
+		/* Most frames and messages see no change, avoid the locked exchange. */
+		if ((CursorState.load(std::memory_order_relaxed) != ECursorState_Visible) == aCursorHidden)
+		{
+			return false;
+		}
+
+		/* The drag started on a visible cursor, so it is already tracked when the cursor hides. */
+		uint32_t state = !aCursorHidden ? ECursorState_Visible : Router.IsDragging() ? ECursorState_Dragged : ECursorState_Hidden;
+
+		return CursorState.exchange(state) == ECursorState_Hidden && !aCursorHidden && aCameraMoving;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ResetCursor:
+	/// 	Moves the cursor to the centre of the client area, or back to its last tracked position,
+	/// 	clamped in case the window moved or shrunk while action cam was on. Traced with where the
+	/// 	reappearance was seen, the replay measures how long the cursor showed at its old position.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::ResetCursor(uint32_t aReset, Trace::EResetFrom aFrom)
+	{
+		TraceEvent(Trace::ERecord_CursorReset, aFrom);
+
+		Geometry::ClientRect rect = Geometry::Unpack(ClientRect.load(std::memory_order_acquire));
+
+		if (aReset == ECursorReset_Center)
+		{
+			Cursor.SetPosition(Geometry::CenterX(rect), Geometry::CenterY(rect));
+			return;
+		}
+
+		Point pos = Geometry::UnpackPoint<Point>(CursorRestore.load(std::memory_order_acquire));
+		Cursor.SetPosition(Geometry::ClampX(rect, pos.x), Geometry::ClampY(rect, pos.y));
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TrackCursorPosition:
+	/// 	Remembers the client-relative cursor position for ResetCursor.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::TrackCursorPosition()
+	{
+		Geometry::ClientRect rect = Geometry::Unpack(ClientRect.load(std::memory_order_acquire));
+		int32_t x = 0;
+		int32_t y = 0;
+		Cursor.GetPosition(x, y);
+		CursorRestore.store(Geometry::PackPoint(x - rect.Left, y - rect.Top), std::memory_order_release);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// UpdateClientRect:
+	/// 	Updates the cached client area from window messages. Returns without round trips for
+	/// 	moves and sizes, which already carry the new client origin/size.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::UpdateClientRect(uint32_t aMsg, int64_t aLParam)
+	{
+		Geometry::ClientRect rect = Geometry::Unpack(ClientRect.load(std::memory_order_relaxed));
+
+		switch (aMsg)
+		{
+			case Input::EMessage_Move:
+			{
+				rect.Left   = (int16_t)(aLParam & 0xFFFF);
+				rect.Top    = (int16_t)((aLParam >> 16) & 0xFFFF);
+				break;
+			}
+			case Input::EMessage_Size:
+			{
+				rect.Width  = (uint16_t)(aLParam & 0xFFFF);
+				rect.Height = (uint16_t)((aLParam >> 16) & 0xFFFF);
+				break;
+			}
+			default:
+			{
+				rect = Window.QueryClientRect();
+				break;
+			}
+		}
+
+		ClientRect.store(Geometry::Pack(rect), std::memory_order_release);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TraceEvent:
+	/// 	Appends an event to the trace while recording.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::TraceEvent(Trace::ERecord aRecord, uint32_t aValue)
+	{
+		if (!Recording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		Profiler::Exempt exempt;
+		const std::lock_guard<std::mutex> lock(TraceMutex);
+		TraceWriter.WriteEvent(Clock.Now(), aRecord, aValue);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TraceMessage:
+	/// 	Appends a message Process acts on to the trace while recording.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::TraceMessage(const Input::Message& aMessage)
+	{
+		if (!Recording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		switch (aMessage.Msg)
+		{
+			case Input::EMessage_SetCursor:
+			case Input::EMessage_MouseMove:
+			case Input::EMessage_Move:
+			case Input::EMessage_Size:
+			case Input::EMessage_DpiChanged:
+			case Input::EMessage_DisplayChange:
+			case Input::EMessage_KeyDown:
+			case Input::EMessage_SysKeyDown:
+			case Input::EMessage_KeyUp:
+			case Input::EMessage_SysKeyUp:
+			case Input::EMessage_LButtonDown:
+			case Input::EMessage_LButtonDblClk:
+			case Input::EMessage_LButtonUp:
+			case Input::EMessage_RButtonDown:
+			case Input::EMessage_RButtonDblClk:
+			case Input::EMessage_RButtonUp:
+			{
+				Profiler::Exempt exempt;
+				const std::lock_guard<std::mutex> lock(TraceMutex);
+				/* Button downs carry the time the chord window is measured with. */
+				TraceWriter.WriteMessage(aMessage.Now ? aMessage.Now : Clock.Now(), aMessage);
+				break;
+			}
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// TraceFrame:
+	/// 	Appends what Frame decided on to the trace, stops recording once the trace is full.
+	///----------------------------------------------------------------------------------------------------
+	void Handler::TraceFrame(const Snapshot& aLink, bool aActionCam, bool aDragging, bool aWantsMouse, int64_t aNow, uint32_t aSuspend)
+	{
+		/* The conditions are not evaluated on these, everything else reaches Activation::Step unless dragging. */
+		constexpr uint32_t notEvaluated = MouseLookHandler::ESuspend_NotGameplay | MouseLookHandler::ESuspend_UiState;
+
+		Trace::Frame frame{};
+		frame.Flags      = (aLink.IsGameplay                              ? (uint32_t)Trace::EFrame_IsGameplay : 0)
+		                 | (aLink.IsMoving                                ? (uint32_t)Trace::EFrame_IsMoving : 0)
+		                 | (aLink.IsCameraMoving                          ? (uint32_t)Trace::EFrame_IsCameraMoving : 0)
+		                 | (aLink.IsCursorHidden                          ? (uint32_t)Trace::EFrame_IsCursorHidden : 0)
+		                 | (aDragging                                     ? (uint32_t)Trace::EFrame_Dragging : 0)
+		                 | (aActionCam                                    ? (uint32_t)Trace::EFrame_ActionCam : 0)
+		                 | (ShouldActivate.load(std::memory_order_relaxed) ? (uint32_t)Trace::EFrame_ShouldActivate : 0)
+		                 | ((aSuspend & notEvaluated) == 0                ? (uint32_t)Trace::EFrame_Evaluated : 0)
+		                 | (aWantsMouse                                   ? (uint32_t)Trace::EFrame_WantsMouse : 0);
+		frame.UiState    = aLink.UiState;
+		frame.MountIndex = aLink.MountIndex;
+		frame.Distance   = (uint32_t)(std::sqrt(aLink.CameraDistanceSq) * 100.0f);
+		frame.Suspend    = aSuspend;
+		frame.Context    = Router.GetContext();
+
+		Profiler::Exempt exempt;
+		const std::lock_guard<std::mutex> lock(TraceMutex);
+		TraceWriter.WriteFrame(aNow, frame);
+
+		if (TraceWriter.Buffer.size() >= TraceLimit)
+		{
+			Recording.store(false, std::memory_order_relaxed);
+		}
+	}
+}
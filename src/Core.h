@@ -0,0 +1,427 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Core.h
+/// Description  :  Platform independent per-frame and per-message decisions and settings handling.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef CORE_H
+#define CORE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Activation.h"
+#include "Geometry.h"
+#include "Input.h"
+#include "Shared.h"
+#include "Trace.h"
+
+///----------------------------------------------------------------------------------------------------
+/// Core Namespace
+/// 	What PreRender and WndProc decide, behind small providers for the game, the cursor, the window,
+/// 	the link data and the clock. The addon implements them on top of Nexus, MumbleLink and Win32,
+/// 	the tests and benchmarks on top of fakes.
+///----------------------------------------------------------------------------------------------------
+namespace Core
+{
+	///----------------------------------------------------------------------------------------------------
+	/// Config:
+	/// 	The user preferences, as stored in settings.json.
+	///----------------------------------------------------------------------------------------------------
+	struct Config
+	{
+		bool        ResetToCenter      = false;
+		bool        RestoreCursor      = false; /* Mutually exclusive with ResetToCenter. */
+		bool        EnableWhileMoving  = true;
+		bool        EnableInCombat     = false;
+		bool        EnableOnMount      = false;
+		bool        EnableWhenZoomedIn = false;
+		/* Camera to avatar distance in meters below which the camera counts as zoomed in, and above which it no longer does. */
+		float       ZoomInDistance     = 3.0f;
+		float       ZoomOutDistance    = 4.0f;
+
+		/* EUiState bits which suspend auto-activation and redirection. */
+		uint32_t    SuspendUiState     = EUiState_MapOpen | EUiState_GameUnfocused | EUiState_TextboxFocused;
+
+		bool        RedirectLMB        = false;
+		bool        RedirectRMB        = false;
+
+		/* Indexed [ERedirectContext][ERedirectButton]. The default context is always used, the others only if overridden. */
+		bool        RedirectOverride[ERedirectContext_COUNT][ERedirectButton_COUNT] = {};
+		Input::Bind RedirectTarget[ERedirectContext_COUNT][ERedirectButton_COUNT]   = {};
+
+		/* Indexed [ERedirectButton][ERedirectModifier]. Overrides the context target while the modifiers are held. */
+		bool        RedirectModifierOverride[ERedirectButton_COUNT][ERedirectModifier_COUNT] = {};
+		Input::Bind RedirectModifierTarget[ERedirectButton_COUNT][ERedirectModifier_COUNT]   = {};
+
+		/* Pressing both buttons within ChordWindowMs of each other triggers ChordTarget instead. */
+		bool        Chord              = false;
+		Input::Bind ChordTarget        = 0;
+		int         ChordWindowMs      = 50;
+
+		bool        RemapKeys          = false;
+
+		/* Indexed by virtual-key code. */
+		bool        KeyRemap[256]       = {};
+		Input::Bind KeyRemapTarget[256] = {};
+
+		/* Virtual-key codes of the game's "Toggle Action Camera"/"Disable Action Camera" binds, 0 if unset. */
+		int         ActionCamKey        = 0;
+		int         ActionCamDisableKey = 0;
+		int         OverrideExpiry      = EOverrideExpiry_OnConditionChange;
+		int         OverrideTimeoutSec  = 30;
+
+		/* Keys the user has bound to UI panels in game, e.g. inventory or map. Indexed by virtual-key code. */
+		bool        ExitOnUiKeys        = false;
+		bool        UiKey[256]          = {};
+	};
+
+	enum ESettings
+	{
+		ESettings_Loaded,
+		ESettings_Migrated,  /* Loaded, but the pre-context redirects were in use and have been reset. */
+		ESettings_Missing,   /* No settings yet, the defaults apply. */
+		ESettings_Malformed  /* Could not be parsed, the defaults apply. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// SerializeSettings:
+	/// 	Returns the settings.json text of a config.
+	///----------------------------------------------------------------------------------------------------
+	std::string SerializeSettings(const Config& aConfig);
+
+	///----------------------------------------------------------------------------------------------------
+	/// DeserializeSettings:
+	/// 	Reads a config from settings.json text. Keys that are missing keep their defaults.
+	/// 	On ESettings_Malformed aError, if given, receives the parser's message.
+	///----------------------------------------------------------------------------------------------------
+	ESettings DeserializeSettings(const std::string& aText, Config& aConfig, std::string* aError = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// LoadSettings / SaveSettings:
+	/// 	The same, from and to a file. SaveSettings returns false if the file could not be written.
+	///----------------------------------------------------------------------------------------------------
+	ESettings LoadSettings(const std::filesystem::path& aPath, Config& aConfig, std::string* aError = nullptr);
+	bool SaveSettings(const std::filesystem::path& aPath, const Config& aConfig);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GameProvider:
+	/// 	Presses and releases game binds and toggles action cam.
+	///----------------------------------------------------------------------------------------------------
+	class GameProvider : public Input::Output
+	{
+	public:
+		/* Immediate toggles reach the game before the message being handled does. */
+		virtual void ToggleActionCam(bool aImmediate) = 0;
+
+	protected:
+		~GameProvider() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// CursorProvider:
+	/// 	Cursor visibility and position in screen coordinates. Called from both threads.
+	///----------------------------------------------------------------------------------------------------
+	class CursorProvider
+	{
+	public:
+		virtual bool IsHidden() = 0;
+		virtual void GetPosition(int32_t& aX, int32_t& aY) = 0;
+		virtual void SetPosition(int32_t aX, int32_t aY) = 0;
+
+	protected:
+		~CursorProvider() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// WindowProvider:
+	/// 	Queries the client area of the game window, in screen coordinates. Message thread only.
+	///----------------------------------------------------------------------------------------------------
+	class WindowProvider
+	{
+	public:
+		virtual Geometry::ClientRect QueryClientRect() = 0;
+
+	protected:
+		~WindowProvider() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// LinkData:
+	/// 	The link fields the decisions are made on, read once per frame.
+	///----------------------------------------------------------------------------------------------------
+	struct LinkData
+	{
+		bool     IsGameplay;
+		bool     IsMoving;
+		bool     IsCameraMoving;
+		uint32_t UiState;          /* EUiState */
+		uint32_t MountIndex;       /* Mumble::EMountIndex, 0 if not mounted. */
+		float    CameraDistanceSq; /* Camera to avatar, in square meters. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// LinkProvider:
+	/// 	The NexusLink and MumbleLink, merged with RTAPI where it is available. Read is render thread
+	/// 	only, IsCameraMoving is also called from the message thread.
+	///----------------------------------------------------------------------------------------------------
+	class LinkProvider
+	{
+	public:
+		virtual void Read(LinkData& aData) = 0;
+		virtual bool IsCameraMoving() = 0;
+
+	protected:
+		~LinkProvider() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// ClockProvider:
+	/// 	A monotonic tick counter, e.g. the performance counter.
+	///----------------------------------------------------------------------------------------------------
+	class ClockProvider
+	{
+	public:
+		virtual int64_t Now() = 0;
+		virtual int64_t TicksPerSecond() = 0;
+
+	protected:
+		~ClockProvider() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Handler:
+	/// 	Frame runs on the render thread, Process on the message thread. Apply and the recording
+	/// 	controls run on the render thread as well and are serialized by the caller.
+	///----------------------------------------------------------------------------------------------------
+	class Handler
+	{
+	public:
+		Handler(GameProvider& aGame, CursorProvider& aCursor, WindowProvider& aWindow, LinkProvider& aLink, ClockProvider& aClock);
+
+		Handler(const Handler&) = delete;
+		Handler& operator=(const Handler&) = delete;
+
+		///----------------------------------------------------------------------------------------------------
+		/// Start:
+		/// 	Sets the state published for other addons and the inhibit channel they write, either may be
+		/// 	null. Must happen before the first Frame or Process.
+		///----------------------------------------------------------------------------------------------------
+		void Start(MouseLookHandler::SharedState* aShared, MouseLookHandler::InhibitChannel* aInhibit);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Stop:
+		/// 	Releases held binds, undoes the addon's action cam and publishes that the state is stale.
+		/// 	Must happen after the last Frame or Process.
+		///----------------------------------------------------------------------------------------------------
+		void Stop();
+
+		///----------------------------------------------------------------------------------------------------
+		/// Apply:
+		/// 	Rebuilds state derived from the config.
+		///----------------------------------------------------------------------------------------------------
+		void Apply(const Config& aConfig);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Frame:
+		/// 	Estimates action cam, selects the redirect context, toggles action cam as needed and
+		/// 	publishes the state. Whether an addon window wants the mouse or keyboard comes from ImGui.
+		///----------------------------------------------------------------------------------------------------
+		void Frame(bool aWantsMouse, bool aWantsKeyboard);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Process:
+		/// 	Handles a window message. The caller fills in Alt for button downs, the rest of the state
+		/// 	is filled in here. Returns true if it was consumed and must not reach the game.
+		///----------------------------------------------------------------------------------------------------
+		bool Process(Input::Message aMessage);
+
+		///----------------------------------------------------------------------------------------------------
+		/// SetHoldSuspended:
+		/// 	Set while the hold-to-suspend bind is held down. Any thread.
+		///----------------------------------------------------------------------------------------------------
+		void SetHoldSuspended(bool aHeld);
+
+		///----------------------------------------------------------------------------------------------------
+		/// InvalidateClientRect / ResetIdentity:
+		/// 	The client area is queried again on the next message, per-character state is reset on the
+		/// 	next frame. Any thread.
+		///----------------------------------------------------------------------------------------------------
+		void InvalidateClientRect();
+		void ResetIdentity();
+
+		///----------------------------------------------------------------------------------------------------
+		/// StartRecording / StopRecording:
+		/// 	Records link frames and input messages, StopRecording returns the trace.
+		///----------------------------------------------------------------------------------------------------
+		void StartRecording();
+		std::vector<uint8_t> StopRecording();
+		bool IsRecording() const;
+
+		///----------------------------------------------------------------------------------------------------
+		/// IsActive:
+		/// 	Returns whether the addon itself turned action cam on.
+		///----------------------------------------------------------------------------------------------------
+		bool IsActive() const;
+
+		const Input::Router& GetRouter() const;
+		Geometry::ClientRect GetClientRect() const;
+
+	private:
+		///----------------------------------------------------------------------------------------------------
+		/// Snapshot:
+		/// 	Link data, cursor visibility and the zoom state, captured once per frame.
+		///----------------------------------------------------------------------------------------------------
+		struct Snapshot : LinkData
+		{
+			bool IsCursorHidden;
+			bool IsZoomedIn;
+		};
+
+		///----------------------------------------------------------------------------------------------------
+		/// TracingOutput:
+		/// 	Passes the router's decisions on to the game and appends them to the trace while recording.
+		///----------------------------------------------------------------------------------------------------
+		class TracingOutput : public Input::Output
+		{
+		public:
+			TracingOutput(Handler& aOwner) : Owner(aOwner) {}
+
+			void Press(Input::Bind aBind) override;
+			void Release(Input::Bind aBind) override;
+			void ButtonUp(uint32_t aMsg, uint64_t aWParam, int64_t aLParam) override;
+
+		private:
+			Handler& Owner;
+		};
+
+		enum ECursorState : uint32_t
+		{
+			ECursorState_Visible,
+			ECursorState_Hidden,
+			ECursorState_Dragged  /* Hidden by a click or camera drag, the game shows it again where it was. */
+		};
+
+		enum ECursorReset : uint32_t
+		{
+			ECursorReset_None,
+			ECursorReset_Center,
+			ECursorReset_Restore
+		};
+
+		typedef bool (*Evaluator)(Handler& aHandler, const Snapshot& aLink);
+
+		template <uint32_t Flags>
+		static bool Evaluate(Handler& aHandler, const Snapshot& aLink);
+
+		template <size_t... Flags>
+		static constexpr std::array<Evaluator, sizeof...(Flags)> MakeEvaluators(std::index_sequence<Flags...>);
+
+		/* One evaluator per EActivationFlags combination, indexed by the flags. */
+		static const std::array<Evaluator, EActivation_COUNT> Evaluators;
+
+		Snapshot TakeSnapshot();
+		uint32_t EvaluateState(const Snapshot& aLink, bool aActionCam, bool aDragging, int64_t aNow, uint32_t aActive, ERedirectContext& aContext);
+		void     PublishState(bool aActionCam, ERedirectContext aContext, uint32_t aSuspend);
+
+		void     ToggleActionCam(bool aImmediate);
+		bool     TakeBackActive();
+		void     ManualOverridePress(uint64_t aWParam, int64_t aLParam);
+		void     UiKeyPress(uint64_t aWParam, int64_t aLParam);
+
+		bool     CursorReappeared(bool aCursorHidden, bool aCameraMoving);
+		void     ResetCursor(uint32_t aReset, Trace::EResetFrom aFrom);
+		void     TrackCursorPosition();
+		void     UpdateClientRect(uint32_t aMsg, int64_t aLParam);
+
+		void     TraceEvent(Trace::ERecord aRecord, uint32_t aValue = 0);
+		void     TraceMessage(const Input::Message& aMessage);
+		void     TraceFrame(const Snapshot& aLink, bool aActionCam, bool aDragging, bool aWantsMouse, int64_t aNow, uint32_t aSuspend);
+
+		GameProvider&                     Game;
+		CursorProvider&                   Cursor;
+		WindowProvider&                   Window;
+		LinkProvider&                     Link;
+		ClockProvider&                    Clock;
+		const int64_t                     TicksPerSecond;
+
+		/* Written by Frame only, other addons read it. */
+		MouseLookHandler::SharedState*    Shared  = nullptr;
+		/* Written by other addons. */
+		MouseLookHandler::InhibitChannel* Inhibit = nullptr;
+
+		/* Click redirects, chords, key remaps and drag tracking. */
+		Input::Router                     Router;
+		TracingOutput                     Output{ *this };
+		/* Settings last applied to the router, kept for the trace header. */
+		Input::Settings                   InputSettings = {};
+
+		/* Recording stops at this size, about an hour of play. */
+		static constexpr size_t           TraceLimit = 64 * 1024 * 1024;
+		std::atomic<bool>                 Recording  = false;
+		/* Guards TraceWriter, which is written by both Frame and Process while recording. */
+		std::mutex                        TraceMutex;
+		Trace::Writer                     TraceWriter;
+
+		/* Evaluator matching the current config, swapped by Apply. */
+		std::atomic<Evaluator>            ActiveEvaluator;
+		/* Config::SuspendUiState, copied for Frame. */
+		std::atomic<uint32_t>             SuspendUiState    = 0;
+		/* Squared zoom thresholds, and the zoom state carried between snapshots for the hysteresis. */
+		std::atomic<float>                ZoomInDistanceSq  = 9.0f;
+		std::atomic<float>                ZoomOutDistanceSq = 16.0f;
+		bool                              ZoomedIn          = false;
+		std::atomic<bool>                 IdentityStale     = false;
+
+		/* Set when a UI key was pressed, blocks auto-activation until Escape or until it would deactivate anyway. */
+		std::atomic<bool>                 UiKeySuspended    = false;
+		/* Set while the hold-to-suspend bind is held down. */
+		std::atomic<bool>                 HoldSuspended     = false;
+		/* Set while typing in chat or an addon window, key presses are text. Published once per frame. */
+		std::atomic<bool>                 Typing            = true;
+		/* Set while key presses are not meant for action cam, i.e. while typing, outside gameplay or in a
+		 * suspending UI state. Published once per frame. */
+		std::atomic<bool>                 KeysSuspended     = true;
+
+		/* Bit 0: whether the addon itself turned action cam on. The bits above count the times Process took
+		 * it back for a UI panel, Frame only commits a toggle if that did not happen since it loaded the word. */
+		std::atomic<uint32_t>             Active            = 0;
+		/* EOverride, set by Process when the player presses their own action cam key. */
+		std::atomic<uint32_t>             Override          = EOverride_None;
+		/* When the override started and the activation conditions at that time. */
+		std::atomic<int64_t>              OverrideSince     = 0;
+		std::atomic<bool>                 OverrideCondition = false;
+		/* When Frame last toggled action cam. Written by Frame only. */
+		std::atomic<int64_t>              ToggledAt         = 0;
+		/* Last evaluated activation conditions, published by Frame. */
+		std::atomic<bool>                 ShouldActivate    = false;
+		/* Toggles invoked by the addon whose key press has not come through Process yet. */
+		std::atomic<uint32_t>             SelfToggles       = 0;
+		std::atomic<int64_t>              SelfToggleExpiry  = 0;
+		/* Override expiry in ticks, rebuilt by Apply. Render thread only. */
+		Activation::Rules                 ActivationRules   = { EOverrideExpiry_OnConditionChange, 0, 0 };
+		/* Config::OverrideExpiry, copied for Process. */
+		std::atomic<int>                  OverrideExpiry    = EOverrideExpiry_OnConditionChange;
+
+		/* ECursorState as last seen by Frame or Process, exchanged so only one of them handles a reappearance. */
+		std::atomic<uint32_t>             CursorState       = ECursorState_Visible;
+		/* Last client-relative cursor position while the cursor was visible, packed by Geometry::PackPoint. */
+		std::atomic<uint64_t>             CursorRestore     = 0;
+		/* ECursorReset matching the current config, swapped by Apply. */
+		std::atomic<uint32_t>             CursorReset       = ECursorReset_None;
+
+		/* Geometry::Pack'd client area, maintained by Process. */
+		std::atomic<uint64_t>             ClientRect        = 0;
+		std::atomic<bool>                 ClientRectStale   = false;
+	};
+}
+
+#endif
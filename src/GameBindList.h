@@ -0,0 +1,226 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  GameBindList.h
+/// Description  :  The game binds the options offer as targets, grouped into menus, with their labels.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef GAMEBINDLIST_H
+#define GAMEBINDLIST_H
+
+///----------------------------------------------------------------------------------------------------
+/// GAME_BIND_MENUS:
+/// 	Calls MENU(name, label) for every menu of the selector, in order.
+///----------------------------------------------------------------------------------------------------
+#define GAME_BIND_MENUS(MENU) \
+	MENU(Movement,      "((Movement))") \
+	MENU(Skills,        "((Skills))") \
+	MENU(Targeting,     "((Targeting))") \
+	MENU(UserInterface, "((User Interface))") \
+	MENU(Camera,        "((Camera))") \
+	MENU(Screenshot,    "((Screenshot))") \
+	MENU(Map,           "((Map))") \
+	MENU(Mounts,        "((Mounts))") \
+	MENU(Spectators,    "((Spectators))") \
+	MENU(Squad,         "((Squad))") \
+	MENU(MasterySkills, "((Mastery Skills))") \
+	MENU(Miscellaneous, "((Miscellaneous))") \
+	MENU(Templates,     "((Templates))")
+
+///----------------------------------------------------------------------------------------------------
+/// GAME_BINDS:
+/// 	Calls BIND(menu, enumerator, label) for every game bind the selector offers, in menu order.
+/// 	The enumerators name EGameBinds values without their prefix.
+///----------------------------------------------------------------------------------------------------
+#define GAME_BINDS(BIND) \
+	BIND(Movement,      MoveForward,                   "((MoveForward))") \
+	BIND(Movement,      MoveBackward,                  "((MoveBackward))") \
+	BIND(Movement,      MoveLeft,                      "((MoveLeft))") \
+	BIND(Movement,      MoveRight,                     "((MoveRight))") \
+	BIND(Movement,      MoveTurnLeft,                  "((MoveTurnLeft))") \
+	BIND(Movement,      MoveTurnRight,                 "((MoveTurnRight))") \
+	BIND(Movement,      MoveDodge,                     "((MoveDodge))") \
+	BIND(Movement,      MoveAutoRun,                   "((MoveAutoRun))") \
+	BIND(Movement,      MoveWalk,                      "((MoveWalk))") \
+	BIND(Movement,      MoveJump_SwimUp_FlyUp,         "((MoveJump))") \
+	BIND(Movement,      MoveSwimDown_FlyDown,          "((MoveSwimDown))") \
+	BIND(Movement,      MoveAboutFace,                 "((MoveAboutFace))") \
+	\
+	BIND(Skills,        SkillWeaponSwap,               "((SkillWeaponSwap))") \
+	BIND(Skills,        SkillWeapon1,                  "((SkillWeapon1))") \
+	BIND(Skills,        SkillWeapon2,                  "((SkillWeapon2))") \
+	BIND(Skills,        SkillWeapon3,                  "((SkillWeapon3))") \
+	BIND(Skills,        SkillWeapon4,                  "((SkillWeapon4))") \
+	BIND(Skills,        SkillWeapon5,                  "((SkillWeapon5))") \
+	BIND(Skills,        SkillHeal,                     "((SkillHeal))") \
+	BIND(Skills,        SkillUtility1,                 "((SkillUtility1))") \
+	BIND(Skills,        SkillUtility2,                 "((SkillUtility2))") \
+	BIND(Skills,        SkillUtility3,                 "((SkillUtility3))") \
+	BIND(Skills,        SkillElite,                    "((SkillElite))") \
+	BIND(Skills,        SkillProfession1,              "((SkillProfession1))") \
+	BIND(Skills,        SkillProfession2,              "((SkillProfession2))") \
+	BIND(Skills,        SkillProfession3,              "((SkillProfession3))") \
+	BIND(Skills,        SkillProfession4,              "((SkillProfession4))") \
+	BIND(Skills,        SkillProfession5,              "((SkillProfession5))") \
+	BIND(Skills,        SkillProfession6,              "((SkillProfession6))") \
+	BIND(Skills,        SkillProfession7,              "((SkillProfession7))") \
+	BIND(Skills,        SkillSpecialAction,            "((SkillSpecialAction))") \
+	\
+	BIND(Targeting,     TargetAlert,                   "((TargetAlert))") \
+	BIND(Targeting,     TargetCall,                    "((TargetCall))") \
+	BIND(Targeting,     TargetTake,                    "((TargetTake))") \
+	BIND(Targeting,     TargetCallLocal,               "((TargetCallLocal))") \
+	BIND(Targeting,     TargetTakeLocal,               "((TargetTakeLocal))") \
+	BIND(Targeting,     TargetEnemyNearest,            "((TargetEnemyNearest))") \
+	BIND(Targeting,     TargetEnemyNext,               "((TargetEnemyNext))") \
+	BIND(Targeting,     TargetEnemyPrev,               "((TargetEnemyPrev))") \
+	BIND(Targeting,     TargetAllyNearest,             "((TargetAllyNearest))") \
+	BIND(Targeting,     TargetAllyNext,                "((TargetAllyNext))") \
+	BIND(Targeting,     TargetAllyPrev,                "((TargetAllyPrev))") \
+	BIND(Targeting,     TargetLock,                    "((TargetLock))") \
+	BIND(Targeting,     TargetSnapGroundTarget,        "((TargetSnapGroundTarget))") \
+	BIND(Targeting,     TargetSnapGroundTargetToggle,  "((TargetSnapGroundTargetToggle))") \
+	BIND(Targeting,     TargetAutoTargetingDisable,    "((TargetAutoTargetingDisable))") \
+	BIND(Targeting,     TargetAutoTargetingToggle,     "((TargetAutoTargetingToggle))") \
+	BIND(Targeting,     TargetAllyTargetingMode,       "((TargetAllyTargetingMode))") \
+	BIND(Targeting,     TargetAllyTargetingModeToggle, "((TargetAllyTargetingModeToggle))") \
+	\
+	BIND(UserInterface, UiCommerce,                    "((UiCommerce))") \
+	BIND(UserInterface, UiContacts,                    "((UiContacts))") \
+	BIND(UserInterface, UiGuild,                       "((UiGuild))") \
+	BIND(UserInterface, UiHero,                        "((UiHero))") \
+	BIND(UserInterface, UiInventory,                   "((UiInventory))") \
+	BIND(UserInterface, UiKennel,                      "((UiKennel))") \
+	BIND(UserInterface, UiLogout,                      "((UiLogout))") \
+	BIND(UserInterface, UiMail,                        "((UiMail))") \
+	BIND(UserInterface, UiOptions,                     "((UiOptions))") \
+	BIND(UserInterface, UiParty,                       "((UiParty))") \
+	BIND(UserInterface, UiPvp,                         "((UiPvp))") \
+	BIND(UserInterface, UiPvpBuild,                    "((UiPvpBuild))") \
+	BIND(UserInterface, UiScoreboard,                  "((UiScoreboard))") \
+	BIND(UserInterface, UiSeasonalObjectivesShop,      "((UiSeasonalObjectivesShop))") \
+	BIND(UserInterface, UiInformation,                 "((UiInformation))") \
+	BIND(UserInterface, UiChatToggle,                  "((UiChatToggle))") \
+	BIND(UserInterface, UiChatCommand,                 "((UiChatCommand))") \
+	BIND(UserInterface, UiChatFocus,                   "((UiChatFocus))") \
+	BIND(UserInterface, UiChatReply,                   "((UiChatReply))") \
+	BIND(UserInterface, UiToggle,                      "((UiToggle))") \
+	BIND(UserInterface, UiSquadBroadcastChatToggle,    "((UiSquadBroadcastChatToggle))") \
+	BIND(UserInterface, UiSquadBroadcastChatCommand,   "((UiSquadBroadcastChatCommand))") \
+	BIND(UserInterface, UiSquadBroadcastChatFocus,     "((UiSquadBroadcastChatFocus))") \
+	\
+	BIND(Camera,        CameraFree,                    "((CameraFree))") \
+	BIND(Camera,        CameraZoomIn,                  "((CameraZoomIn))") \
+	BIND(Camera,        CameraZoomOut,                 "((CameraZoomOut))") \
+	BIND(Camera,        CameraReverse,                 "((CameraReverse))") \
+	BIND(Camera,        CameraActionMode,              "((CameraActionMode))") \
+	BIND(Camera,        CameraActionModeDisable,       "((CameraActionModeDisable))") \
+	\
+	BIND(Screenshot,    ScreenshotNormal,              "((ScreenshotNormal))") \
+	BIND(Screenshot,    ScreenshotStereoscopic,        "((ScreenshotStereoscopic))") \
+	\
+	BIND(Map,           MapToggle,                     "((MapToggle))") \
+	BIND(Map,           MapFocusPlayer,                "((MapFocusPlayer))") \
+	BIND(Map,           MapFloorDown,                  "((MapFloorDown))") \
+	BIND(Map,           MapFloorUp,                    "((MapFloorUp))") \
+	BIND(Map,           MapZoomIn,                     "((MapZoomIn))") \
+	BIND(Map,           MapZoomOut,                    "((MapZoomOut))") \
+	\
+	BIND(Mounts,        SpumoniToggle,                 "((SpumoniToggle))") \
+	BIND(Mounts,        SpumoniMovement,               "((SpumoniMovement))") \
+	BIND(Mounts,        SpumoniSecondaryMovement,      "((SpumoniSecondaryMovement))") \
+	BIND(Mounts,        SpumoniMAM01,                  "((SpumoniMAM01))") \
+	BIND(Mounts,        SpumoniMAM02,                  "((SpumoniMAM02))") \
+	BIND(Mounts,        SpumoniMAM03,                  "((SpumoniMAM03))") \
+	BIND(Mounts,        SpumoniMAM04,                  "((SpumoniMAM04))") \
+	BIND(Mounts,        SpumoniMAM05,                  "((SpumoniMAM05))") \
+	BIND(Mounts,        SpumoniMAM06,                  "((SpumoniMAM06))") \
+	BIND(Mounts,        SpumoniMAM07,                  "((SpumoniMAM07))") \
+	BIND(Mounts,        SpumoniMAM08,                  "((SpumoniMAM08))") \
+	BIND(Mounts,        SpumoniMAM09,                  "((SpumoniMAM09))") \
+	\
+	BIND(Spectators,    SpectatorNearestFixed,         "((SpectatorNearestFixed))") \
+	BIND(Spectators,    SpectatorNearestPlayer,        "((SpectatorNearestPlayer))") \
+	BIND(Spectators,    SpectatorPlayerRed1,           "((SpectatorPlayerRed1))") \
+	BIND(Spectators,    SpectatorPlayerRed2,           "((SpectatorPlayerRed2))") \
+	BIND(Spectators,    SpectatorPlayerRed3,           "((SpectatorPlayerRed3))") \
+	BIND(Spectators,    SpectatorPlayerRed4,           "((SpectatorPlayerRed4))") \
+	BIND(Spectators,    SpectatorPlayerRed5,           "((SpectatorPlayerRed5))") \
+	BIND(Spectators,    SpectatorPlayerBlue1,          "((SpectatorPlayerBlue1))") \
+	BIND(Spectators,    SpectatorPlayerBlue2,          "((SpectatorPlayerBlue2))") \
+	BIND(Spectators,    SpectatorPlayerBlue3,          "((SpectatorPlayerBlue3))") \
+	BIND(Spectators,    SpectatorPlayerBlue4,          "((SpectatorPlayerBlue4))") \
+	BIND(Spectators,    SpectatorPlayerBlue5,          "((SpectatorPlayerBlue5))") \
+	BIND(Spectators,    SpectatorFreeCamera,           "((SpectatorFreeCamera))") \
+	BIND(Spectators,    SpectatorFreeCameraMode,       "((SpectatorFreeCameraMode))") \
+	BIND(Spectators,    SpectatorFreeMoveForward,      "((SpectatorFreeMoveForward))") \
+	BIND(Spectators,    SpectatorFreeMoveBackward,     "((SpectatorFreeMoveBackward))") \
+	BIND(Spectators,    SpectatorFreeMoveLeft,         "((SpectatorFreeMoveLeft))") \
+	BIND(Spectators,    SpectatorFreeMoveRight,        "((SpectatorFreeMoveRight))") \
+	BIND(Spectators,    SpectatorFreeMoveUp,           "((SpectatorFreeMoveUp))") \
+	BIND(Spectators,    SpectatorFreeMoveDown,         "((SpectatorFreeMoveDown))") \
+	\
+	BIND(Squad,         SquadMarkerPlaceWorld1,        "((SquadMarkerPlaceWorld1))") \
+	BIND(Squad,         SquadMarkerPlaceWorld2,        "((SquadMarkerPlaceWorld2))") \
+	BIND(Squad,         SquadMarkerPlaceWorld3,        "((SquadMarkerPlaceWorld3))") \
+	BIND(Squad,         SquadMarkerPlaceWorld4,        "((SquadMarkerPlaceWorld4))") \
+	BIND(Squad,         SquadMarkerPlaceWorld5,        "((SquadMarkerPlaceWorld5))") \
+	BIND(Squad,         SquadMarkerPlaceWorld6,        "((SquadMarkerPlaceWorld6))") \
+	BIND(Squad,         SquadMarkerPlaceWorld7,        "((SquadMarkerPlaceWorld7))") \
+	BIND(Squad,         SquadMarkerPlaceWorld8,        "((SquadMarkerPlaceWorld8))") \
+	BIND(Squad,         SquadMarkerClearAllWorld,      "((SquadMarkerClearAllWorld))") \
+	BIND(Squad,         SquadMarkerSetAgent1,          "((SquadMarkerSetAgent1))") \
+	BIND(Squad,         SquadMarkerSetAgent2,          "((SquadMarkerSetAgent2))") \
+	BIND(Squad,         SquadMarkerSetAgent3,          "((SquadMarkerSetAgent3))") \
+	BIND(Squad,         SquadMarkerSetAgent4,          "((SquadMarkerSetAgent4))") \
+	BIND(Squad,         SquadMarkerSetAgent5,          "((SquadMarkerSetAgent5))") \
+	BIND(Squad,         SquadMarkerSetAgent6,          "((SquadMarkerSetAgent6))") \
+	BIND(Squad,         SquadMarkerSetAgent7,          "((SquadMarkerSetAgent7))") \
+	BIND(Squad,         SquadMarkerSetAgent8,          "((SquadMarkerSetAgent8))") \
+	BIND(Squad,         SquadMarkerClearAllAgent,      "((SquadMarkerClearAllAgent))") \
+	\
+	BIND(MasterySkills, MasteryAccess,                 "((MasteryAccess))") \
+	BIND(MasterySkills, MasteryAccess01,               "((MasteryAccess01))") \
+	BIND(MasterySkills, MasteryAccess02,               "((MasteryAccess02))") \
+	BIND(MasterySkills, MasteryAccess03,               "((MasteryAccess03))") \
+	BIND(MasterySkills, MasteryAccess04,               "((MasteryAccess04))") \
+	BIND(MasterySkills, MasteryAccess05,               "((MasteryAccess05))") \
+	BIND(MasterySkills, MasteryAccess06,               "((MasteryAccess06))") \
+	\
+	BIND(Miscellaneous, MiscAoELoot,                   "((MiscAoELoot))") \
+	BIND(Miscellaneous, MiscInteract,                  "((MiscInteract))") \
+	BIND(Miscellaneous, MiscShowEnemies,               "((MiscShowEnemies))") \
+	BIND(Miscellaneous, MiscShowAllies,                "((MiscShowAllies))") \
+	BIND(Miscellaneous, MiscCombatStance,              "((MiscCombatStance))") \
+	BIND(Miscellaneous, MiscToggleLanguage,            "((MiscToggleLanguage))") \
+	BIND(Miscellaneous, MiscTogglePetCombat,           "((MiscTogglePetCombat))") \
+	BIND(Miscellaneous, MiscToggleFullScreen,          "((MiscToggleFullScreen))") \
+	BIND(Miscellaneous, MiscToggleDecorationMode,      "((MiscToggleDecorationMode))") \
+	BIND(Miscellaneous, ToyUseDefault,                 "((ToyUseDefault))") \
+	BIND(Miscellaneous, ToyUseSlot1,                   "((ToyUseSlot1))") \
+	BIND(Miscellaneous, ToyUseSlot2,                   "((ToyUseSlot2))") \
+	BIND(Miscellaneous, ToyUseSlot3,                   "((ToyUseSlot3))") \
+	BIND(Miscellaneous, ToyUseSlot4,                   "((ToyUseSlot4))") \
+	BIND(Miscellaneous, ToyUseSlot5,                   "((ToyUseSlot5))") \
+	\
+	BIND(Templates,     Loadout1,                      "((Loadout1))") \
+	BIND(Templates,     Loadout2,                      "((Loadout2))") \
+	BIND(Templates,     Loadout3,                      "((Loadout3))") \
+	BIND(Templates,     Loadout4,                      "((Loadout4))") \
+	BIND(Templates,     Loadout5,                      "((Loadout5))") \
+	BIND(Templates,     Loadout6,                      "((Loadout6))") \
+	BIND(Templates,     Loadout7,                      "((Loadout7))") \
+	BIND(Templates,     Loadout8,                      "((Loadout8))") \
+	BIND(Templates,     Loadout9,                      "((Loadout9))") \
+	BIND(Templates,     GearLoadout1,                  "((GearLoadout1))") \
+	BIND(Templates,     GearLoadout2,                  "((GearLoadout2))") \
+	BIND(Templates,     GearLoadout3,                  "((GearLoadout3))") \
+	BIND(Templates,     GearLoadout4,                  "((GearLoadout4))") \
+	BIND(Templates,     GearLoadout5,                  "((GearLoadout5))") \
+	BIND(Templates,     GearLoadout6,                  "((GearLoadout6))") \
+	BIND(Templates,     GearLoadout7,                  "((GearLoadout7))") \
+	BIND(Templates,     GearLoadout8,                  "((GearLoadout8))") \
+	BIND(Templates,     GearLoadout9,                  "((GearLoadout9))")
+
+#endif
@@ -0,0 +1,112 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  GameBinds.h
+/// Description  :  Labels of the game binds and the selector over them. EGameBinds must be declared
+/// 				before, by Nexus in the addon or from GameBindList.h where Nexus is not available.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef GAMEBINDS_H
+#define GAMEBINDS_H
+
+#include "GameBindList.h"
+#include "Input.h"
+#include "Profiler.h"
+
+///----------------------------------------------------------------------------------------------------
+/// GameBinds Namespace
+///----------------------------------------------------------------------------------------------------
+namespace GameBinds
+{
+	enum EMenu
+	{
+#define GAME_BIND_MENUS_ENUM(aName, aLabel) EMenu_##aName,
+		GAME_BIND_MENUS(GAME_BIND_MENUS_ENUM)
+#undef GAME_BIND_MENUS_ENUM
+		EMenu_COUNT
+	};
+
+#define GAME_BIND_MENUS_LABEL(aName, aLabel) aLabel,
+	inline constexpr const char* MenuLabels[EMenu_COUNT] = { GAME_BIND_MENUS(GAME_BIND_MENUS_LABEL) };
+#undef GAME_BIND_MENUS_LABEL
+
+	struct Entry
+	{
+		EMenu       Menu;
+		EGameBinds  Bind;
+		const char* Label;
+	};
+
+#define GAME_BINDS_ENTRY(aMenu, aName, aLabel) Entry{ EMenu_##aMenu, EGameBinds_##aName, aLabel },
+	inline constexpr Entry Entries[] = { GAME_BINDS(GAME_BINDS_ENTRY) };
+#undef GAME_BINDS_ENTRY
+
+	///----------------------------------------------------------------------------------------------------
+	/// ToString:
+	/// 	Returns the untranslated label of a game bind, empty if the selector does not offer it.
+	///----------------------------------------------------------------------------------------------------
+	inline const char* ToString(EGameBinds aGameBind)
+	{
+		Profiler::Scope profile(Profiler::EEntry_GameBindToString);
+
+		switch (aGameBind)
+		{
+#define GAME_BINDS_CASE(aMenu, aName, aLabel) case EGameBinds_##aName: return aLabel;
+			GAME_BINDS(GAME_BINDS_CASE)
+#undef GAME_BINDS_CASE
+			default: break;
+		}
+
+		return "";
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Selector:
+	/// 	Dropdown of the game binds grouped into menus. The UI renders the elements, the addon with ImGui:
+	/// 		bool BeginCombo(const char* aIdentifier, const char* aPreview); void EndCombo();
+	/// 		bool BeginMenu(const char* aLabel);                             void EndMenu();
+	/// 		void Selectable(Input::Bind* aTarget, const char* aLabel, EGameBinds aGameBind);
+	///----------------------------------------------------------------------------------------------------
+	template <typename UI>
+	void Selector(UI& aUi, const char* aIdentifier, Input::Bind* aTarget)
+	{
+		Profiler::Scope profile(Profiler::EEntry_GbSelector);
+
+		if (!aUi.BeginCombo(aIdentifier, ToString((EGameBinds)*aTarget)))
+		{
+			return;
+		}
+
+		int  menu = -1;
+		bool open = false;
+
+		for (const Entry& entry : Entries)
+		{
+			if (entry.Menu != menu)
+			{
+				if (open)
+				{
+					aUi.EndMenu();
+				}
+
+				menu = entry.Menu;
+				open = aUi.BeginMenu(MenuLabels[menu]);
+			}
+
+			if (open)
+			{
+				aUi.Selectable(aTarget, entry.Label, entry.Bind);
+			}
+		}
+
+		if (open)
+		{
+			aUi.EndMenu();
+		}
+
+		aUi.EndCombo();
+	}
+}
+
+#endif
@@ -0,0 +1,113 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Geometry.h
+/// Description  :  Window geometry helpers.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// Geometry Namespace
+///----------------------------------------------------------------------------------------------------
+namespace Geometry
+{
+	///----------------------------------------------------------------------------------------------------
+	/// ClientRect:
+	/// 	Client area of a window in screen coordinates.
+	///----------------------------------------------------------------------------------------------------
+	struct ClientRect
+	{
+		int32_t Left;
+		int32_t Top;
+		int32_t Width;
+		int32_t Height;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Pack:
+	/// 	Packs a client rect into 64 bits, so it can be published with a single atomic store.
+	/// 	Each component is truncated to 16 bits, which covers any virtual screen.
+	///----------------------------------------------------------------------------------------------------
+	inline uint64_t Pack(const ClientRect& aRect)
+	{
+		return ((uint64_t)(uint16_t)aRect.Left)
+			| ((uint64_t)(uint16_t)aRect.Top << 16)
+			| ((uint64_t)(uint16_t)aRect.Width << 32)
+			| ((uint64_t)(uint16_t)aRect.Height << 48);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Unpack:
+	/// 	Inverse of Pack.
+	///----------------------------------------------------------------------------------------------------
+	inline ClientRect Unpack(uint64_t aPacked)
+	{
+		return ClientRect{
+			(int16_t)(aPacked & 0xFFFF),
+			(int16_t)((aPacked >> 16) & 0xFFFF),
+			(uint16_t)((aPacked >> 32) & 0xFFFF),
+			(uint16_t)((aPacked >> 48) & 0xFFFF)
+		};
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// PackPoint:
+	/// 	Packs a point into 64 bits, so it can be published with a single atomic store.
+	///----------------------------------------------------------------------------------------------------
+	inline uint64_t PackPoint(int32_t aX, int32_t aY)
+	{
+		return ((uint64_t)(uint32_t)aX) | ((uint64_t)(uint32_t)aY << 32);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// UnpackPoint:
+	/// 	Inverse of PackPoint, into any struct with x and y members.
+	///----------------------------------------------------------------------------------------------------
+	template <typename T>
+	inline T UnpackPoint(uint64_t aPacked)
+	{
+		T point{};
+		point.x = (int32_t)(uint32_t)(aPacked & 0xFFFFFFFF);
+		point.y = (int32_t)(uint32_t)(aPacked >> 32);
+		return point;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// CenterX / CenterY:
+	/// 	Returns the centre of a client rect in screen coordinates.
+	///----------------------------------------------------------------------------------------------------
+	inline int32_t CenterX(const ClientRect& aRect)
+	{
+		return aRect.Left + aRect.Width / 2;
+	}
+
+	inline int32_t CenterY(const ClientRect& aRect)
+	{
+		return aRect.Top + aRect.Height / 2;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ClampX / ClampY:
+	/// 	Converts a client-relative coordinate to screen coordinates, clamped into the client rect.
+	///----------------------------------------------------------------------------------------------------
+	inline int32_t ClampX(const ClientRect& aRect, int32_t aClientX)
+	{
+		if (aClientX >= aRect.Width) { aClientX = aRect.Width - 1; }
+		if (aClientX < 0)            { aClientX = 0; }
+		return aRect.Left + aClientX;
+	}
+
+	inline int32_t ClampY(const ClientRect& aRect, int32_t aClientY)
+	{
+		if (aClientY >= aRect.Height) { aClientY = aRect.Height - 1; }
+		if (aClientY < 0)             { aClientY = 0; }
+		return aRect.Top + aClientY;
+	}
+}
+
+#endif
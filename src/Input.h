@@ -0,0 +1,681 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Input.h
+/// Description  :  Platform independent click redirect, chord, key remap and drag decisions.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <atomic>
+#include <cstdint>
+
+enum ERedirectButton
+{
+	ERedirectButton_LMB,
+	ERedirectButton_RMB,
+	ERedirectButton_COUNT
+};
+
+/* Bit layout matches MK_SHIFT/MK_CONTROL shifted down by two, Alt is taken from the key state. */
+enum ERedirectModifier
+{
+	ERedirectModifier_None  = 0,
+	ERedirectModifier_Shift = 1 << 0,
+	ERedirectModifier_Ctrl  = 1 << 1,
+	ERedirectModifier_Alt   = 1 << 2,
+	ERedirectModifier_COUNT = 1 << 3 /* Number of modifier combinations. */
+};
+
+enum ERedirectContext
+{
+	ERedirectContext_Default,
+	ERedirectContext_Combat,
+	ERedirectContext_Mount,
+	ERedirectContext_COUNT
+};
+
+///----------------------------------------------------------------------------------------------------
+/// Input Namespace
+/// 	Decides what to do with window messages from plain values, without touching the game, the
+/// 	window or the Nexus API, so it can be driven from recorded or synthetic input.
+///----------------------------------------------------------------------------------------------------
+namespace Input
+{
+	/* Values of the Win32 messages the router and Core::Handler handle, so they build without windows.h. */
+	enum EMessage : uint32_t
+	{
+		EMessage_Move          = 0x0003,
+		EMessage_Size          = 0x0005,
+		EMessage_SetCursor     = 0x0020,
+		EMessage_DisplayChange = 0x007E,
+		EMessage_KeyDown       = 0x0100,
+		EMessage_KeyUp         = 0x0101,
+		EMessage_SysKeyDown    = 0x0104,
+		EMessage_SysKeyUp      = 0x0105,
+		EMessage_MouseMove     = 0x0200,
+		EMessage_LButtonDown   = 0x0201,
+		EMessage_LButtonUp     = 0x0202,
+		EMessage_LButtonDblClk = 0x0203,
+		EMessage_RButtonDown   = 0x0204,
+		EMessage_RButtonUp     = 0x0205,
+		EMessage_RButtonDblClk = 0x0206,
+		EMessage_DpiChanged    = 0x02E0
+	};
+
+	/* Values of the MK_ flags in the wParam of mouse messages. Buttons match 1 << ERedirectButton. */
+	enum EMouseKey : uint32_t
+	{
+		EMouseKey_LButton = 0x1,
+		EMouseKey_RButton = 0x2,
+		EMouseKey_Shift   = 0x4,
+		EMouseKey_Control = 0x8
+	};
+
+	/* EGameBinds, kept as a plain integer so the Nexus headers are not needed. */
+	typedef uint32_t Bind;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Settings:
+	/// 	The part of the config the router acts on.
+	///----------------------------------------------------------------------------------------------------
+	struct Settings
+	{
+		bool Redirect[ERedirectButton_COUNT];
+
+		/* Indexed [ERedirectContext][ERedirectButton]. The default context is always used, the others only if overridden. */
+		bool RedirectOverride[ERedirectContext_COUNT][ERedirectButton_COUNT];
+		Bind RedirectTarget[ERedirectContext_COUNT][ERedirectButton_COUNT];
+
+		/* Indexed [ERedirectButton][ERedirectModifier]. Overrides the context target while the modifiers are held. */
+		bool RedirectModifierOverride[ERedirectButton_COUNT][ERedirectModifier_COUNT];
+		Bind RedirectModifierTarget[ERedirectButton_COUNT][ERedirectModifier_COUNT];
+
+		bool Chord;
+		Bind ChordTarget;
+		int  ChordWindowMs;
+
+		/* Indexed by virtual-key code. */
+		bool RemapKeys;
+		bool KeyRemap[256];
+		Bind KeyRemapTarget[256];
+
+		bool ExitOnUiKeys;
+		bool UiKey[256];
+
+		/* Virtual-key codes of the game's own action cam binds, 0 if unset. */
+		int  ActionCamKey;
+		int  ActionCamDisableKey;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Output:
+	/// 	Where the router's decisions go, the game in the addon and a fake in tests and replays.
+	///----------------------------------------------------------------------------------------------------
+	class Output
+	{
+	public:
+		virtual void Press(Bind aBind) = 0;
+		virtual void Release(Bind aBind) = 0;
+
+		/* Sends a button up to the game only, to cancel a press it already saw. */
+		virtual void ButtonUp(uint32_t aMsg, uint64_t aWParam, int64_t aLParam) = 0;
+
+	protected:
+		~Output() = default;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Message:
+	/// 	A window message and the state it is handled in.
+	///----------------------------------------------------------------------------------------------------
+	struct Message
+	{
+		uint32_t Msg;          /* EMessage */
+		uint64_t WParam;
+		int64_t  LParam;
+		int64_t  Now;          /* Monotonic ticks, same unit as passed to Router::Apply. */
+		bool     Alt;          /* Mouse messages do not carry it. */
+		bool     CursorHidden;
+		bool     Inhibited;    /* Another addon inhibits action cam. */
+	};
+
+	/* Atomic entries, the message thread reads them while Apply may be rebuilding the table. */
+	typedef std::atomic<Bind> RedirectRow[ERedirectButton_COUNT][ERedirectModifier_COUNT];
+
+	///----------------------------------------------------------------------------------------------------
+	/// Router:
+	/// 	Settings are applied and per-frame state is published from the render thread, messages are
+	/// 	processed on the message thread. Held binds are message thread only.
+	///----------------------------------------------------------------------------------------------------
+	class Router
+	{
+	public:
+		Router()
+		{
+			/* Zero would remap to MoveForward, nothing is remapped until settings are applied. */
+			for (std::atomic<int32_t>& remap : KeyRemapResolved)
+			{
+				remap.store(-1, std::memory_order_relaxed);
+			}
+		}
+
+		Router(const Router&) = delete;
+		Router& operator=(const Router&) = delete;
+
+		///----------------------------------------------------------------------------------------------------
+		/// Apply:
+		/// 	Rebuilds the tables derived from the settings. Not reentrant, callers serialize it.
+		///----------------------------------------------------------------------------------------------------
+		void Apply(const Settings& aSettings, int64_t aTicksPerSecond)
+		{
+			for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+			{
+				for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+				{
+					Bind contextTarget = aSettings.RedirectOverride[ctx][btn]
+						? aSettings.RedirectTarget[ctx][btn]
+						: aSettings.RedirectTarget[ERedirectContext_Default][btn];
+
+					for (int mod = 0; mod < ERedirectModifier_COUNT; mod++)
+					{
+						RedirectResolved[ctx][btn][mod].store(aSettings.RedirectModifierOverride[btn][mod]
+							? aSettings.RedirectModifierTarget[btn][mod]
+							: contextTarget, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			RedirectButtons.store((aSettings.Redirect[ERedirectButton_LMB] ? 1u << ERedirectButton_LMB : 0)
+			                    | (aSettings.Redirect[ERedirectButton_RMB] ? 1u << ERedirectButton_RMB : 0), std::memory_order_relaxed);
+
+			ChordWindow.store(aSettings.Chord ? (aTicksPerSecond * aSettings.ChordWindowMs / 1000 > 1 ? aTicksPerSecond * aSettings.ChordWindowMs / 1000 : 1) : 0, std::memory_order_relaxed);
+			ChordTarget.store(aSettings.ChordTarget, std::memory_order_relaxed);
+
+			for (int vk = 0; vk < 256; vk++)
+			{
+				KeyRemapResolved[vk].store(aSettings.RemapKeys && aSettings.KeyRemap[vk] ? (int32_t)aSettings.KeyRemapTarget[vk] : -1, std::memory_order_relaxed);
+			}
+
+			uint64_t uiKeys[4] = {};
+			for (int vk = 0; vk < 256 && aSettings.ExitOnUiKeys; vk++)
+			{
+				if (aSettings.UiKey[vk])
+				{
+					uiKeys[vk >> 6] |= 1ull << (vk & 63);
+				}
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				UiKeys[i].store(uiKeys[i], std::memory_order_relaxed);
+			}
+
+			ActionCamKey.store(aSettings.ActionCamKey, std::memory_order_relaxed);
+			ActionCamDisableKey.store(aSettings.ActionCamDisableKey, std::memory_order_relaxed);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// SetContext / Suspend:
+		/// 	Selects the redirect targets of a context, or stops redirecting and remapping. Once per frame.
+		///----------------------------------------------------------------------------------------------------
+		void SetContext(ERedirectContext aContext)
+		{
+			Active.store(&RedirectResolved[aContext], std::memory_order_release);
+		}
+
+		void Suspend()
+		{
+			Active.store(nullptr, std::memory_order_release);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// SetActionCam / SetWantsMouse:
+		/// 	Publishes the action cam estimate and whether an addon window wants the mouse. Once per frame.
+		///----------------------------------------------------------------------------------------------------
+		void SetActionCam(bool aActionCam)
+		{
+			ActionCam.store(aActionCam, std::memory_order_release);
+		}
+
+		void SetWantsMouse(bool aWantsMouse)
+		{
+			WantsMouse.store(aWantsMouse, std::memory_order_relaxed);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// GetContext:
+		/// 	Returns the current ERedirectContext, ERedirectContext_COUNT while suspended.
+		///----------------------------------------------------------------------------------------------------
+		uint32_t GetContext() const
+		{
+			const RedirectRow* active = Active.load(std::memory_order_acquire);
+			return active ? (uint32_t)(active - RedirectResolved) : (uint32_t)ERedirectContext_COUNT;
+		}
+
+		bool IsActionCam() const
+		{
+			return ActionCam.load(std::memory_order_acquire);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// IsDragging:
+		/// 	Returns whether a button that went down on a visible cursor is still held, i.e. the cursor
+		/// 	is hidden by a click or camera drag rather than by action cam.
+		///----------------------------------------------------------------------------------------------------
+		bool IsDragging() const
+		{
+			return DragButtons.load(std::memory_order_acquire) != 0;
+		}
+
+		bool IsUiKey(uint32_t aVirtualKey) const
+		{
+			return (UiKeys[(aVirtualKey & 0xFF) >> 6].load(std::memory_order_relaxed) >> (aVirtualKey & 63)) & 1;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// TogglePanel:
+		/// 	Tracks the game's UI panels by their keys, each press of a UI key opens or closes its panel.
+		/// 	Returns whether the panel is open afterwards.
+		///----------------------------------------------------------------------------------------------------
+		bool TogglePanel(uint32_t aVirtualKey)
+		{
+			uint64_t bit = 1ull << (aVirtualKey & 63);
+			return (OpenPanels[(aVirtualKey & 0xFF) >> 6].fetch_xor(bit, std::memory_order_relaxed) & bit) == 0;
+		}
+
+		bool IsPanelOpen() const
+		{
+			for (const std::atomic<uint64_t>& panels : OpenPanels)
+			{
+				if (panels.load(std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// ClosePanels:
+		/// 	Forgets all open panels, e.g. on Escape or once they can no longer be open. Any thread.
+		///----------------------------------------------------------------------------------------------------
+		void ClosePanels()
+		{
+			for (std::atomic<uint64_t>& panels : OpenPanels)
+			{
+				panels.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		int GetActionCamKey() const
+		{
+			return ActionCamKey.load(std::memory_order_relaxed);
+		}
+
+		int GetActionCamDisableKey() const
+		{
+			return ActionCamDisableKey.load(std::memory_order_relaxed);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// Process:
+		/// 	Handles a message. Returns true if it was consumed and must not reach the game.
+		///----------------------------------------------------------------------------------------------------
+		bool Process(const Message& aMsg, Output& aOutput)
+		{
+			switch (aMsg.Msg)
+			{
+				case EMessage_KeyDown:
+				case EMessage_SysKeyDown:
+				{
+					return KeyDown(aMsg, aOutput);
+				}
+				case EMessage_KeyUp:
+				case EMessage_SysKeyUp:
+				{
+					KeyUp((uint32_t)(aMsg.WParam & 0xFF), aOutput);
+
+					/* Releases should always be passed on. */
+					return false;
+				}
+				case EMessage_MouseMove:
+				{
+					/* Drop buttons whose up was missed e.g. when released outside the window. Message thread only writes. */
+					uint32_t drag = DragButtons.load(std::memory_order_relaxed);
+					if (drag & ~(uint32_t)aMsg.WParam)
+					{
+						DragButtons.store(drag & (uint32_t)aMsg.WParam, std::memory_order_release);
+					}
+
+					/* The same for binds pressed in their place, otherwise they stick until the next click. */
+					for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+					{
+						if (!((aMsg.WParam >> btn) & 1))
+						{
+							ChordRelease(aOutput);
+							RedirectRelease((ERedirectButton)btn, aOutput);
+						}
+					}
+					return false;
+				}
+				/* Release held redirects even if action cam was left in between, otherwise the bind sticks. */
+				case EMessage_LButtonUp:
+				{
+					ButtonUp(ERedirectButton_LMB, aOutput);
+					return false;
+				}
+				case EMessage_RButtonUp:
+				{
+					ButtonUp(ERedirectButton_RMB, aOutput);
+					return false;
+				}
+				case EMessage_LButtonDown:
+				case EMessage_LButtonDblClk:
+				{
+					return ButtonDown(ERedirectButton_LMB, aMsg, aOutput);
+				}
+				case EMessage_RButtonDown:
+				case EMessage_RButtonDblClk:
+				{
+					return ButtonDown(ERedirectButton_RMB, aMsg, aOutput);
+				}
+			}
+
+			return false;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// ReleaseAll:
+		/// 	Releases every bind still held, e.g. on unload.
+		///----------------------------------------------------------------------------------------------------
+		void ReleaseAll(Output& aOutput)
+		{
+			ChordRelease(aOutput);
+
+			for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+			{
+				RedirectRelease((ERedirectButton)btn, aOutput);
+			}
+
+			for (uint32_t vk = 0; vk < 256; vk++)
+			{
+				KeyUp(vk, aOutput);
+			}
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// Held:
+		/// 	Returns the number of binds currently held down.
+		///----------------------------------------------------------------------------------------------------
+		uint32_t Held() const
+		{
+			uint32_t held = ChordIsHeld ? 1 : 0;
+
+			for (bool isHeld : RedirectIsHeld)
+			{
+				held += isHeld ? 1 : 0;
+			}
+
+			for (bool isHeld : KeyRemapIsHeld)
+			{
+				held += isHeld ? 1 : 0;
+			}
+
+			return held;
+		}
+
+	private:
+		///----------------------------------------------------------------------------------------------------
+		/// ButtonDown:
+		/// 	Tells drags apart from action cam clicks, then tries the chord and the redirect.
+		///----------------------------------------------------------------------------------------------------
+		bool ButtonDown(ERedirectButton aButton, const Message& aMsg, Output& aOutput)
+		{
+			/* Drop buttons whose up was missed e.g. on focus loss. */
+			uint32_t drag = DragButtons.load(std::memory_order_relaxed) & (uint32_t)(aMsg.WParam & (EMouseKey_LButton | EMouseKey_RButton));
+
+			/* A button going down on a visible cursor starts a click or camera drag, not action cam. */
+			if (!aMsg.CursorHidden)
+			{
+				drag |= 1u << aButton;
+			}
+
+			DragButtons.store(drag, std::memory_order_release);
+
+			if (drag)
+			{
+				return false;
+			}
+
+			/* Another addon wants the mouse, e.g. for an interactive window. */
+			if (!ActionCam.load(std::memory_order_acquire) || aMsg.Inhibited)
+			{
+				return false;
+			}
+
+			if (ChordPress(aButton, aMsg, aOutput))
+			{
+				return true;
+			}
+
+			if (RedirectButtons.load(std::memory_order_relaxed) & (1u << aButton))
+			{
+				return RedirectPress(aButton, aMsg, aOutput);
+			}
+
+			return false;
+		}
+
+		void ButtonUp(ERedirectButton aButton, Output& aOutput)
+		{
+			DragButtons.fetch_and(~(1u << aButton), std::memory_order_release);
+			ChordRelease(aOutput);
+			RedirectRelease(aButton, aOutput);
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// RedirectPress:
+		/// 	Presses the currently active target of a button and modifier combination and remembers it
+		/// 	for the release.
+		/// 	Returns false if redirection is suspended and the input should be passed on.
+		///----------------------------------------------------------------------------------------------------
+		bool RedirectPress(ERedirectButton aButton, const Message& aMsg, Output& aOutput)
+		{
+			const RedirectRow* active = Active.load(std::memory_order_acquire);
+
+			/* Suspended, or the click is meant for an addon window. */
+			if (!active || WantsMouse.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			unsigned modifiers = ((aMsg.WParam >> 2) & (ERedirectModifier_Shift | ERedirectModifier_Ctrl))
+			                   | (aMsg.Alt ? ERedirectModifier_Alt : ERedirectModifier_None);
+
+			Bind target = (*active)[aButton][modifiers].load(std::memory_order_relaxed);
+
+			/* A repeated down (e.g. double click) without an up in between still has the old bind held. */
+			if (RedirectIsHeld[aButton] && RedirectHeld[aButton] != target)
+			{
+				aOutput.Release(RedirectHeld[aButton]);
+			}
+
+			aOutput.Press(target);
+			RedirectHeld[aButton]   = target;
+			RedirectIsHeld[aButton] = true;
+
+			return true;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// RedirectRelease:
+		/// 	Releases whichever bind was pressed for a button.
+		///----------------------------------------------------------------------------------------------------
+		void RedirectRelease(ERedirectButton aButton, Output& aOutput)
+		{
+			if (!RedirectIsHeld[aButton])
+			{
+				return;
+			}
+
+			aOutput.Release(RedirectHeld[aButton]);
+			RedirectIsHeld[aButton] = false;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// ChordPress:
+		/// 	Tracks button downs and turns a second button going down within the chord window into the
+		/// 	chord bind. The first button's press is cancelled. Returns true if the input was consumed.
+		///----------------------------------------------------------------------------------------------------
+		bool ChordPress(ERedirectButton aButton, const Message& aMsg, Output& aOutput)
+		{
+			int64_t window = ChordWindow.load(std::memory_order_relaxed);
+
+			/* Disabled, or the click is meant for an addon window. */
+			if (window == 0 || WantsMouse.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			ERedirectButton other = aButton == ERedirectButton_LMB ? ERedirectButton_RMB : ERedirectButton_LMB;
+
+			/* The state of the other button as of this message. */
+			bool otherDown = (aMsg.WParam >> other) & 1;
+
+			if (ChordIsHeld || !otherDown || aMsg.Now - ButtonDownTime[other] > window)
+			{
+				ButtonDownTime[aButton] = aMsg.Now;
+				return false;
+			}
+
+			/* Cancel the first press, whether it was redirected or went to the game. */
+			if (RedirectIsHeld[other])
+			{
+				RedirectRelease(other, aOutput);
+			}
+			else
+			{
+				aOutput.ButtonUp(other == ERedirectButton_LMB ? EMessage_LButtonUp : EMessage_RButtonUp, aMsg.WParam & ~(1ull << other), aMsg.LParam);
+			}
+
+			/* Both downs are used up, holding one button and pressing the other again is no new chord. */
+			ButtonDownTime[other] = aMsg.Now - window - 1;
+
+			ChordHeld   = ChordTarget.load(std::memory_order_relaxed);
+			ChordIsHeld = true;
+			aOutput.Press(ChordHeld);
+
+			return true;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// ChordRelease:
+		/// 	Releases the chord bind once either button goes up.
+		///----------------------------------------------------------------------------------------------------
+		void ChordRelease(Output& aOutput)
+		{
+			if (!ChordIsHeld)
+			{
+				return;
+			}
+
+			aOutput.Release(ChordHeld);
+			ChordIsHeld = false;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// KeyDown:
+		/// 	Presses the remapped bind of a key. Returns true if the key was consumed.
+		///----------------------------------------------------------------------------------------------------
+		bool KeyDown(const Message& aMsg, Output& aOutput)
+		{
+			uint32_t vk = aMsg.WParam & 0xFF;
+
+			/* Bit 30: previous key state, set on autorepeat. */
+			if (aMsg.LParam & (1 << 30))
+			{
+				/* Swallow the repeats of a remapped key, the bind is already held. Pass on keys the game saw go down. */
+				return KeyRemapIsHeld[vk];
+			}
+
+			int32_t target = KeyRemapResolved[vk].load(std::memory_order_relaxed);
+
+			if (target < 0)
+			{
+				return false;
+			}
+
+			if (!ActionCam.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			/* Suspended the same way as click redirects. */
+			if (!Active.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			aOutput.Press((Bind)target);
+			KeyRemapHeld[vk]   = (Bind)target;
+			KeyRemapIsHeld[vk] = true;
+
+			return true;
+		}
+
+		///----------------------------------------------------------------------------------------------------
+		/// KeyUp:
+		/// 	Releases whichever bind was pressed for a key.
+		///----------------------------------------------------------------------------------------------------
+		void KeyUp(uint32_t aVirtualKey, Output& aOutput)
+		{
+			if (!KeyRemapIsHeld[aVirtualKey])
+			{
+				return;
+			}
+
+			aOutput.Release(KeyRemapHeld[aVirtualKey]);
+			KeyRemapIsHeld[aVirtualKey] = false;
+		}
+
+		/* Effective redirect targets per context, button and modifiers. */
+		RedirectRow                     RedirectResolved[ERedirectContext_COUNT] = {};
+		/* Row of RedirectResolved for the current context, null while suspended. */
+		std::atomic<const RedirectRow*> Active            { &RedirectResolved[ERedirectContext_Default] };
+		/* Bit per ERedirectButton whose clicks are redirected. */
+		std::atomic<uint32_t>           RedirectButtons   { 0 };
+		/* Chord window in ticks, 0 if chords are disabled. */
+		std::atomic<int64_t>            ChordWindow       { 0 };
+		std::atomic<Bind>               ChordTarget       { 0 };
+		/* Effective key remaps per virtual-key code, -1 if not remapped or remapping is off. */
+		std::atomic<int32_t>            KeyRemapResolved[256];
+		/* Bitset of the UI keys, empty if leaving action cam for UI panels is off. */
+		std::atomic<uint64_t>           UiKeys[4]         = {};
+		std::atomic<int>                ActionCamKey      { 0 };
+		std::atomic<int>                ActionCamDisableKey { 0 };
+
+		/* Bitset of the UI keys whose panel is open. */
+		std::atomic<uint64_t>           OpenPanels[4]     = {};
+
+		/* Estimate whether action cam is on, published once per frame. */
+		std::atomic<bool>               ActionCam         { false };
+		/* ImGui::GetIO().WantCaptureMouse, published once per frame so the message thread never touches ImGui. */
+		std::atomic<bool>               WantsMouse        { false };
+		/* Buttons that went down while the cursor was visible and are still held, bit per ERedirectButton. */
+		std::atomic<uint32_t>           DragButtons       { 0 };
+
+		/* Binds that were pressed, so the release matches even if the settings or context changed in between. */
+		Bind                            RedirectHeld[ERedirectButton_COUNT]   = {};
+		bool                            RedirectIsHeld[ERedirectButton_COUNT] = {};
+		/* Ticks at the last down per button. */
+		int64_t                         ButtonDownTime[ERedirectButton_COUNT] = {};
+		Bind                            ChordHeld         = 0;
+		bool                            ChordIsHeld       = false;
+		Bind                            KeyRemapHeld[256] = {};
+		bool                            KeyRemapIsHeld[256] = {};
+	};
+}
+
+#endif
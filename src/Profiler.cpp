@@ -0,0 +1,108 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Profiler.cpp
+/// Description  :  Timing and allocation counters for the addon's entry points.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Profiler.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace Profiler
+{
+	static std::atomic<bool> s_Enabled                = false;
+	static Counters          s_Counters[EEntry_COUNT] = {};
+
+	/* Counted by the replaced operator new below if it is built, per thread so concurrent entry points do
+	 * not mix. */
+	static thread_local uint64_t t_Allocations        = 0;
+	static thread_local uint32_t t_ExemptDepth        = 0;
+
+	Counters& Get(EEntry aEntry)
+	{
+		return s_Counters[aEntry];
+	}
+
+	bool IsEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	void SetEnabled(bool aEnabled)
+	{
+		if (aEnabled)
+		{
+			for (Counters& counters : s_Counters)
+			{
+				counters.Calls.store(0, std::memory_order_relaxed);
+				counters.Nanoseconds.store(0, std::memory_order_relaxed);
+				counters.Allocations.store(0, std::memory_order_relaxed);
+				counters.Violations.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		s_Enabled.store(aEnabled, std::memory_order_relaxed);
+	}
+
+	uint64_t Allocations()
+	{
+		return t_Allocations;
+	}
+
+	Exempt::Exempt()
+	{
+		t_ExemptDepth++;
+	}
+
+	Exempt::~Exempt()
+	{
+		t_ExemptDepth--;
+	}
+}
+
+#ifdef MLH_TRACK_ALLOCATIONS
+/* Replaced for this module only, the game and other addons keep their own allocators. The array and
+ * sized forms are replaced as well, compilers call sized delete directly when they know the size. */
+void* operator new(size_t aSize)
+{
+	if (Profiler::t_ExemptDepth == 0)
+	{
+		Profiler::t_Allocations++;
+	}
+
+	if (void* ptr = std::malloc(aSize ? aSize : 1))
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* aPtr) noexcept
+{
+	std::free(aPtr);
+}
+
+void* operator new[](size_t aSize)
+{
+	return operator new(aSize);
+}
+
+void operator delete[](void* aPtr) noexcept
+{
+	operator delete(aPtr);
+}
+
+void operator delete(void* aPtr, size_t) noexcept
+{
+	operator delete(aPtr);
+}
+
+void operator delete[](void* aPtr, size_t) noexcept
+{
+	operator delete(aPtr);
+}
+#endif
@@ -0,0 +1,143 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Profiler.h
+/// Description  :  Timing and allocation counters for the addon's entry points.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// Profiler Namespace
+///----------------------------------------------------------------------------------------------------
+namespace Profiler
+{
+	enum EEntry
+	{
+		EEntry_WndProc,
+		EEntry_PreRender,
+		EEntry_RenderOptions,
+		EEntry_LoadSettings,
+		EEntry_SaveSettings,
+		EEntry_GameBindToString,
+		EEntry_GbSelector,
+		EEntry_COUNT
+	};
+
+	struct Counters
+	{
+		std::atomic<uint64_t> Calls;
+		std::atomic<uint64_t> Nanoseconds;
+		std::atomic<uint64_t> Allocations;
+		std::atomic<uint64_t> Violations;  /* Calls of a steady-state entry point that allocated. */
+	};
+
+	/* Allocations are counted by replacing operator new, which only the test and bench targets do. */
+#ifdef MLH_TRACK_ALLOCATIONS
+	constexpr bool TracksAllocations = true;
+#else
+	constexpr bool TracksAllocations = false;
+#endif
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsSteadyState:
+	/// 	Returns whether an entry point must not allocate, i.e. runs per frame or per message.
+	///----------------------------------------------------------------------------------------------------
+	constexpr bool IsSteadyState(EEntry aEntry)
+	{
+		return aEntry == EEntry_WndProc || aEntry == EEntry_PreRender;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Get:
+	/// 	Returns the counters of an entry point.
+	///----------------------------------------------------------------------------------------------------
+	Counters& Get(EEntry aEntry);
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsEnabled:
+	/// 	Returns whether entry points are currently measured.
+	///----------------------------------------------------------------------------------------------------
+	bool IsEnabled();
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetEnabled:
+	/// 	Starts or stops measuring, starting resets all counters.
+	///----------------------------------------------------------------------------------------------------
+	void SetEnabled(bool aEnabled);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Allocations:
+	/// 	Returns the number of operator new calls made by this module on the calling thread, outside
+	/// 	of Exempt scopes. Always 0 unless TracksAllocations.
+	///----------------------------------------------------------------------------------------------------
+	uint64_t Allocations();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Exempt:
+	/// 	Allocations within its lifetime are not counted, e.g. appending to a trace while recording.
+	///----------------------------------------------------------------------------------------------------
+	struct Exempt
+	{
+		Exempt();
+		~Exempt();
+
+		Exempt(const Exempt&) = delete;
+		Exempt& operator=(const Exempt&) = delete;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Scope:
+	/// 	Measures an entry point from construction to destruction. A single load while disabled.
+	///----------------------------------------------------------------------------------------------------
+	struct Scope
+	{
+		Scope(EEntry aEntry)
+			: Entry(aEntry)
+			, Enabled(IsEnabled())
+		{
+			if (Enabled)
+			{
+				AllocationsStart = Allocations();
+				Start = std::chrono::steady_clock::now();
+			}
+		}
+
+		~Scope()
+		{
+			if (!Enabled)
+			{
+				return;
+			}
+
+			uint64_t ns          = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+			uint64_t allocations = Allocations() - AllocationsStart;
+
+			Counters& counters = Get(Entry);
+			counters.Calls.fetch_add(1, std::memory_order_relaxed);
+			counters.Nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+			counters.Allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+			if (allocations && IsSteadyState(Entry))
+			{
+				counters.Violations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		EEntry                                Entry;
+		bool                                  Enabled;
+		uint64_t                              AllocationsStart = 0;
+		std::chrono::steady_clock::time_point Start;
+	};
+}
+
+#endif
@@ -0,0 +1,193 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Shared.h
+/// Description  :  State shared with other addons via DataLink.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef SHARED_H
+#define SHARED_H
+
+#include <atomic>
+#include <cstdint>
+
+#define DL_MLH_STATE      "DL_MOUSELOOKHANDLER_STATE"
+#define MLH_STATE_VERSION 1
+#define DL_MLH_INHIBIT    "DL_MOUSELOOKHANDLER_INHIBIT"
+
+///----------------------------------------------------------------------------------------------------
+/// MouseLookHandler Namespace
+/// 	Include this header from other addons to read the state or to inhibit action cam.
+///----------------------------------------------------------------------------------------------------
+namespace MouseLookHandler
+{
+	enum EProfile : uint32_t
+	{
+		EProfile_Default,
+		EProfile_Combat,
+		EProfile_Mount
+	};
+
+	/* Why the addon currently does not evaluate action cam, 0 if it does. */
+	enum ESuspend : uint32_t
+	{
+		ESuspend_None           = 0,
+		ESuspend_NotGameplay    = 1 << 0,  /* Loading screen, character select, cutscene. */
+		ESuspend_UiState        = 1 << 1,  /* Map open, chat focused, game unfocused, ... */
+		ESuspend_Hold           = 1 << 2,  /* Hold-to-suspend bind held down. */
+		ESuspend_UiKey          = 1 << 3,  /* A UI panel was opened. */
+		ESuspend_Dragging       = 1 << 4,  /* Camera dragged by mouse. */
+		ESuspend_ManualOverride = 1 << 5,  /* The player toggled action cam by hand. */
+		ESuspend_Inhibit        = 1 << 6,  /* Another addon set its InhibitChannel bit. */
+		ESuspend_Unloaded       = 1u << 31 /* The addon was unloaded, the state is stale. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// SharedState:
+	/// 	Published via DataLink DL_MLH_STATE once per frame. Guarded by a seqlock: Sequence is odd
+	/// 	while a write is in progress. Use Read() rather than loading the fields directly.
+	///----------------------------------------------------------------------------------------------------
+	struct alignas(64) SharedState
+	{
+		std::atomic<uint32_t> Version;     /* MLH_STATE_VERSION */
+		std::atomic<uint32_t> Sequence;
+		std::atomic<uint32_t> IsActionCam; /* Estimate: the cursor is captured by the game and not by a drag. */
+		std::atomic<uint32_t> Profile;     /* EProfile */
+		std::atomic<uint32_t> Suspend;     /* ESuspend */
+	};
+
+	static_assert(sizeof(SharedState) == 64, "SharedState must fit a single cache line.");
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "SharedState is read across modules.");
+
+	///----------------------------------------------------------------------------------------------------
+	/// State:
+	/// 	Consistent copy of SharedState.
+	///----------------------------------------------------------------------------------------------------
+	struct State
+	{
+		uint32_t Sequence;
+		bool     IsActionCam;
+		EProfile Profile;
+		uint32_t Suspend;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Read:
+	/// 	Copies a consistent state. Returns false if aShared is null or of another version.
+	///----------------------------------------------------------------------------------------------------
+	inline bool Read(const SharedState* aShared, State* aOut)
+	{
+		if (!aShared || aShared->Version.load(std::memory_order_acquire) != MLH_STATE_VERSION)
+		{
+			return false;
+		}
+
+		uint32_t sequence;
+		do
+		{
+			sequence = aShared->Sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+			{
+				continue;
+			}
+
+			/* Acquire loads rather than a fence keep the Sequence check below after them, and ThreadSanitizer
+			 * understands them. */
+			aOut->Sequence    = sequence;
+			aOut->IsActionCam = aShared->IsActionCam.load(std::memory_order_acquire) != 0;
+			aOut->Profile     = (EProfile)aShared->Profile.load(std::memory_order_acquire);
+			aOut->Suspend     = aShared->Suspend.load(std::memory_order_acquire);
+		} while ((sequence & 1) || aShared->Sequence.load(std::memory_order_relaxed) != sequence);
+
+		return true;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Write:
+	/// 	Publishes a state under the seqlock. Only the addon itself writes, from a single thread.
+	///----------------------------------------------------------------------------------------------------
+	inline void Write(SharedState* aShared, bool aIsActionCam, EProfile aProfile, uint32_t aSuspend)
+	{
+		uint32_t sequence = aShared->Sequence.load(std::memory_order_relaxed);
+		aShared->Sequence.store(sequence + 1, std::memory_order_relaxed);
+
+		/* Release stores order the odd Sequence before the fields for a reader that sees any of them. */
+		aShared->IsActionCam.store(aIsActionCam, std::memory_order_release);
+		aShared->Profile.store(aProfile, std::memory_order_release);
+		aShared->Suspend.store(aSuspend, std::memory_order_release);
+
+		aShared->Sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// InhibitChannel:
+	/// 	Shared via DataLink DL_MLH_INHIBIT. Each cooperating addon claims one bit and sets it while
+	/// 	action cam should stay off, e.g. while it shows an interactive window. Any set bit suspends.
+	/// 	Obtain it with DataLink.Share(DL_MLH_INHIBIT, sizeof(InhibitChannel)), not Get, so it exists
+	/// 	regardless of load order.
+	///----------------------------------------------------------------------------------------------------
+	struct alignas(64) InhibitChannel
+	{
+		std::atomic<uint64_t> Inhibit;
+		std::atomic<uint64_t> Claimed;
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "InhibitChannel is written across modules.");
+
+	///----------------------------------------------------------------------------------------------------
+	/// ClaimInhibit:
+	/// 	Claims a free bit. Returns its index or -1 if all are taken.
+	///----------------------------------------------------------------------------------------------------
+	inline int ClaimInhibit(InhibitChannel* aChannel)
+	{
+		uint64_t claimed = aChannel->Claimed.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			int bit = 0;
+			while (bit < 64 && (claimed & (1ull << bit)))
+			{
+				bit++;
+			}
+
+			if (bit == 64)
+			{
+				return -1;
+			}
+
+			if (aChannel->Claimed.compare_exchange_weak(claimed, claimed | (1ull << bit), std::memory_order_relaxed))
+			{
+				return bit;
+			}
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetInhibit:
+	/// 	Sets or clears a claimed bit.
+	///----------------------------------------------------------------------------------------------------
+	inline void SetInhibit(InhibitChannel* aChannel, int aBit, bool aInhibit)
+	{
+		if (aInhibit)
+		{
+			aChannel->Inhibit.fetch_or(1ull << aBit, std::memory_order_release);
+		}
+		else
+		{
+			aChannel->Inhibit.fetch_and(~(1ull << aBit), std::memory_order_release);
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReleaseInhibit:
+	/// 	Clears and returns a claimed bit, e.g. on unload.
+	///----------------------------------------------------------------------------------------------------
+	inline void ReleaseInhibit(InhibitChannel* aChannel, int aBit)
+	{
+		SetInhibit(aChannel, aBit, false);
+		aChannel->Claimed.fetch_and(~(1ull << aBit), std::memory_order_relaxed);
+	}
+}
+
+#endif
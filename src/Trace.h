@@ -0,0 +1,630 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Trace.h
+/// Description  :  Compact binary traces of link frames and input messages, and their replay.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Activation.h"
+#include "Input.h"
+
+#define TRACE_MAGIC   0x54484C4D /* "MLHT" */
+#define TRACE_VERSION 5
+
+///----------------------------------------------------------------------------------------------------
+/// Trace Namespace
+/// 	A trace is a header followed by records. The header holds everything the replay needs to start
+/// 	from the recorded state: the tick frequency, the activation rules and state, the suspending UI
+/// 	states and the input settings. Every record starts with its ERecord kind and the ticks since the previous record,
+/// 	frames only carry the fields that changed since the last frame. All integers are LEB128 varints.
+///----------------------------------------------------------------------------------------------------
+namespace Trace
+{
+	enum ERecord : uint8_t
+	{
+		ERecord_Frame,       /* PreRender */
+		ERecord_Message,     /* WndProc: uMsg, wParam, lParam, EMessageFlags */
+		ERecord_Toggle,      /* Output: action cam toggled */
+		ERecord_Press,       /* Output: game bind pressed */
+		ERecord_Release,     /* Output: game bind released */
+		ERecord_Override,    /* WndProc: manual override started, EOverride | condition << 8 */
+		ERecord_ClearActive, /* WndProc: action cam dropped for a UI panel */
+		ERecord_ButtonUp,    /* Output: button up sent to the game only, uMsg */
+		ERecord_CursorReset  /* WndProc or PreRender: cursor reset after it reappeared, EResetFrom */
+	};
+
+	enum EResetFrom : uint8_t
+	{
+		EResetFrom_Message,
+		EResetFrom_Frame
+	};
+
+	enum EFrameFlags : uint32_t
+	{
+		EFrame_IsGameplay     = 1 << 0,
+		EFrame_IsMoving       = 1 << 1,
+		EFrame_IsCameraMoving = 1 << 2,
+		EFrame_IsCursorHidden = 1 << 3,
+		EFrame_Dragging       = 1 << 4,
+		EFrame_ActionCam      = 1 << 5,
+		EFrame_ShouldActivate = 1 << 6,
+		EFrame_Evaluated      = 1 << 7, /* The conditions were evaluated. The replay derives it from IsGameplay and UiState. */
+		EFrame_WantsMouse     = 1 << 8
+	};
+
+	enum EFrameFields : uint8_t
+	{
+		EField_UiState    = 1 << 0,
+		EField_MountIndex = 1 << 1,
+		EField_Distance   = 1 << 2,
+		EField_Suspend    = 1 << 3,
+		EField_Context    = 1 << 4
+	};
+
+	enum EMessageFlags : uint8_t
+	{
+		EMessageFlag_Alt          = 1 << 0,
+		EMessageFlag_CursorHidden = 1 << 1,
+		EMessageFlag_Inhibited    = 1 << 2
+	};
+
+	enum ESettingsFlags : uint8_t
+	{
+		ESettings_RedirectLMB  = 1 << 0,
+		ESettings_RedirectRMB  = 1 << 1,
+		ESettings_Chord        = 1 << 2,
+		ESettings_RemapKeys    = 1 << 3,
+		ESettings_ExitOnUiKeys = 1 << 4
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Frame:
+	/// 	Everything PreRender decided on.
+	///----------------------------------------------------------------------------------------------------
+	struct Frame
+	{
+		uint32_t Flags;      /* EFrameFlags */
+		uint32_t UiState;    /* EUiState */
+		uint32_t MountIndex;
+		uint32_t Distance;   /* Camera to avatar, centimeters. */
+		uint32_t Suspend;    /* MouseLookHandler::ESuspend */
+		uint32_t Context;    /* ERedirectContext the router was left in, ERedirectContext_COUNT if suspended. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Writer:
+	/// 	Appends records to a buffer. Not thread-safe.
+	///----------------------------------------------------------------------------------------------------
+	class Writer
+	{
+	public:
+		void Begin(int64_t aTicksPerSecond, const Activation::Rules& aRules, const Activation::State& aState, const Input::Settings& aSettings, uint32_t aSuspendUiState, int64_t aNow)
+		{
+			Buffer.clear();
+			Last      = aNow;
+			LastFrame = {};
+
+			WriteVarint(TRACE_MAGIC);
+			WriteVarint(TRACE_VERSION);
+			WriteVarint((uint64_t)aTicksPerSecond);
+			WriteVarint((uint64_t)aRules.OverrideExpiry);
+			WriteVarint((uint64_t)aRules.OverrideTimeout);
+			WriteVarint((uint64_t)aRules.ToggleLatency);
+			WriteVarint(aState.WasActive);
+			WriteVarint(aState.Override | (aState.OverrideCondition << 8));
+			/* Age of the override, so a timeout expires when it did in game. */
+			WriteVarint(aState.Override != EOverride_None && aNow > aState.OverrideSince ? (uint64_t)(aNow - aState.OverrideSince) : 0);
+			/* Age of the last toggle, so a toggle still on its way keeps WasActive as it did in game. */
+			WriteVarint(aNow > aState.ToggledAt ? (uint64_t)(aNow - aState.ToggledAt) : 0);
+			WriteVarint(aSuspendUiState);
+			WriteSettings(aSettings);
+		}
+
+		void WriteFrame(int64_t aNow, const Frame& aFrame)
+		{
+			uint8_t changed = (aFrame.UiState    != LastFrame.UiState    ? EField_UiState    : 0)
+			                | (aFrame.MountIndex != LastFrame.MountIndex ? EField_MountIndex : 0)
+			                | (aFrame.Distance   != LastFrame.Distance   ? EField_Distance   : 0)
+			                | (aFrame.Suspend    != LastFrame.Suspend    ? EField_Suspend    : 0)
+			                | (aFrame.Context    != LastFrame.Context    ? EField_Context    : 0);
+
+			WriteHeader(ERecord_Frame, aNow);
+			WriteVarint(aFrame.Flags);
+			Buffer.push_back(changed);
+			if (changed & EField_UiState)    { WriteVarint(aFrame.UiState); }
+			if (changed & EField_MountIndex) { WriteVarint(aFrame.MountIndex); }
+			if (changed & EField_Distance)   { WriteVarint(aFrame.Distance); }
+			if (changed & EField_Suspend)    { WriteVarint(aFrame.Suspend); }
+			if (changed & EField_Context)    { WriteVarint(aFrame.Context); }
+
+			LastFrame = aFrame;
+		}
+
+		void WriteMessage(int64_t aNow, const Input::Message& aMessage)
+		{
+			WriteHeader(ERecord_Message, aNow);
+			WriteVarint(aMessage.Msg);
+			WriteVarint(aMessage.WParam);
+			WriteVarint((uint64_t)aMessage.LParam);
+			WriteVarint((aMessage.Alt          ? EMessageFlag_Alt          : 0)
+			          | (aMessage.CursorHidden ? EMessageFlag_CursorHidden : 0)
+			          | (aMessage.Inhibited    ? EMessageFlag_Inhibited    : 0));
+		}
+
+		void WriteEvent(int64_t aNow, ERecord aRecord, uint32_t aValue = 0)
+		{
+			WriteHeader(aRecord, aNow);
+			if (aRecord == ERecord_Press || aRecord == ERecord_Release || aRecord == ERecord_Override || aRecord == ERecord_ButtonUp || aRecord == ERecord_CursorReset)
+			{
+				WriteVarint(aValue);
+			}
+		}
+
+		std::vector<uint8_t> Buffer;
+
+	private:
+		void WriteHeader(ERecord aRecord, int64_t aNow)
+		{
+			/* Records from different threads may be a few ticks out of order. */
+			uint64_t delta = aNow > Last ? (uint64_t)(aNow - Last) : 0;
+			Last = aNow > Last ? aNow : Last;
+
+			Buffer.push_back(aRecord);
+			WriteVarint(delta);
+		}
+
+		void WriteSettings(const Input::Settings& aSettings)
+		{
+			WriteVarint((aSettings.Redirect[ERedirectButton_LMB] ? ESettings_RedirectLMB  : 0)
+			          | (aSettings.Redirect[ERedirectButton_RMB] ? ESettings_RedirectRMB  : 0)
+			          | (aSettings.Chord                         ? ESettings_Chord        : 0)
+			          | (aSettings.RemapKeys                     ? ESettings_RemapKeys    : 0)
+			          | (aSettings.ExitOnUiKeys                  ? ESettings_ExitOnUiKeys : 0));
+
+			/* Targets shifted up by one, the low bit is whether they are overridden. */
+			for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+			{
+				for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+				{
+					WriteVarint(((uint64_t)aSettings.RedirectTarget[ctx][btn] << 1) | aSettings.RedirectOverride[ctx][btn]);
+				}
+			}
+			for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+			{
+				for (int mod = 0; mod < ERedirectModifier_COUNT; mod++)
+				{
+					WriteVarint(((uint64_t)aSettings.RedirectModifierTarget[btn][mod] << 1) | aSettings.RedirectModifierOverride[btn][mod]);
+				}
+			}
+
+			WriteVarint(aSettings.ChordTarget);
+			WriteVarint((uint64_t)aSettings.ChordWindowMs);
+
+			/* Remapped and UI keys as counted lists, most of the 256 keys are neither. */
+			uint64_t remaps = 0;
+			uint64_t uiKeys = 0;
+			for (int vk = 0; vk < 256; vk++)
+			{
+				remaps += aSettings.KeyRemap[vk];
+				uiKeys += aSettings.UiKey[vk];
+			}
+
+			WriteVarint(remaps);
+			for (int vk = 0; vk < 256; vk++)
+			{
+				if (aSettings.KeyRemap[vk])
+				{
+					WriteVarint((uint64_t)vk);
+					WriteVarint(aSettings.KeyRemapTarget[vk]);
+				}
+			}
+
+			WriteVarint(uiKeys);
+			for (int vk = 0; vk < 256; vk++)
+			{
+				if (aSettings.UiKey[vk])
+				{
+					WriteVarint((uint64_t)vk);
+				}
+			}
+
+			WriteVarint((uint64_t)aSettings.ActionCamKey);
+			WriteVarint((uint64_t)aSettings.ActionCamDisableKey);
+		}
+
+		void WriteVarint(uint64_t aValue)
+		{
+			while (aValue >= 0x80)
+			{
+				Buffer.push_back((uint8_t)(aValue | 0x80));
+				aValue >>= 7;
+			}
+			Buffer.push_back((uint8_t)aValue);
+		}
+
+		int64_t Last      = 0;
+		Frame   LastFrame = {};
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadVarint:
+	/// 	Reads a varint at aPos. Returns false past the end of the buffer.
+	///----------------------------------------------------------------------------------------------------
+	inline bool ReadVarint(const std::vector<uint8_t>& aBuffer, size_t& aPos, uint64_t& aValue)
+	{
+		aValue = 0;
+		for (int shift = 0; shift < 64 && aPos < aBuffer.size(); shift += 7)
+		{
+			uint8_t byte = aBuffer[aPos++];
+			aValue |= (uint64_t)(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadSettings:
+	/// 	Reads the input settings written by Writer::Begin. Returns false if they are malformed.
+	///----------------------------------------------------------------------------------------------------
+	inline bool ReadSettings(const std::vector<uint8_t>& aBuffer, size_t& aPos, Input::Settings& aSettings)
+	{
+		uint64_t value;
+
+		if (!ReadVarint(aBuffer, aPos, value))
+		{
+			return false;
+		}
+		aSettings.Redirect[ERedirectButton_LMB] = (value & ESettings_RedirectLMB) != 0;
+		aSettings.Redirect[ERedirectButton_RMB] = (value & ESettings_RedirectRMB) != 0;
+		aSettings.Chord                         = (value & ESettings_Chord) != 0;
+		aSettings.RemapKeys                     = (value & ESettings_RemapKeys) != 0;
+		aSettings.ExitOnUiKeys                  = (value & ESettings_ExitOnUiKeys) != 0;
+
+		for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+		{
+			for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+			{
+				if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+				aSettings.RedirectTarget[ctx][btn]   = (Input::Bind)(value >> 1);
+				aSettings.RedirectOverride[ctx][btn] = value & 1;
+			}
+		}
+		for (int btn = 0; btn < ERedirectButton_COUNT; btn++)
+		{
+			for (int mod = 0; mod < ERedirectModifier_COUNT; mod++)
+			{
+				if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+				aSettings.RedirectModifierTarget[btn][mod]   = (Input::Bind)(value >> 1);
+				aSettings.RedirectModifierOverride[btn][mod] = value & 1;
+			}
+		}
+
+		if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+		aSettings.ChordTarget = (Input::Bind)value;
+		if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+		aSettings.ChordWindowMs = (int)value;
+
+		uint64_t count, vk;
+		if (!ReadVarint(aBuffer, aPos, count) || count > 256) { return false; }
+		for (uint64_t i = 0; i < count; i++)
+		{
+			if (!ReadVarint(aBuffer, aPos, vk) || vk > 255 || !ReadVarint(aBuffer, aPos, value)) { return false; }
+			aSettings.KeyRemap[vk]       = true;
+			aSettings.KeyRemapTarget[vk] = (Input::Bind)value;
+		}
+
+		if (!ReadVarint(aBuffer, aPos, count) || count > 256) { return false; }
+		for (uint64_t i = 0; i < count; i++)
+		{
+			if (!ReadVarint(aBuffer, aPos, vk) || vk > 255) { return false; }
+			aSettings.UiKey[vk] = true;
+		}
+
+		if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+		aSettings.ActionCamKey = (int)value;
+		if (!ReadVarint(aBuffer, aPos, value)) { return false; }
+		aSettings.ActionCamDisableKey = (int)value;
+
+		return true;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// CursorJump:
+	/// 	A cursor reset and how long the cursor may have been visible at its old position before it.
+	/// 	The cursor reappears at some point after the last frame that saw it hidden, so the window
+	/// 	is an upper bound, accurate to a frame.
+	///----------------------------------------------------------------------------------------------------
+	struct CursorJump
+	{
+		double     Milliseconds; /* From the last frame that saw the cursor hidden to the reset. */
+		uint32_t   Frames;       /* Frames that finished with the cursor visible before the reset. */
+		EResetFrom From;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Printer:
+	/// 	Formats outputs one line each, replayed ones from Input::Router and recorded ones alike.
+	///----------------------------------------------------------------------------------------------------
+	class Printer : public Input::Output
+	{
+	public:
+		Printer(std::string& aOut, int64_t aTicksPerSecond)
+			: Out(aOut)
+			, TicksPerSecond(aTicksPerSecond)
+		{
+		}
+
+		void Press(Input::Bind aBind) override
+		{
+			Line("press", aBind);
+		}
+
+		void Release(Input::Bind aBind) override
+		{
+			Line("release", aBind);
+		}
+
+		void ButtonUp(uint32_t aMsg, uint64_t, int64_t) override
+		{
+			Line("buttonup", aMsg);
+		}
+
+		void Toggle()
+		{
+			Line("toggle");
+		}
+
+		int64_t Now = 0;
+
+	private:
+		void Line(const char* aWhat, int64_t aValue = -1)
+		{
+			char line[64];
+			double ms = Now * 1000.0 / TicksPerSecond;
+
+			if (aValue >= 0)
+			{
+				snprintf(line, sizeof(line), "%.3f %s %lld\n", ms, aWhat, (long long)aValue);
+			}
+			else
+			{
+				snprintf(line, sizeof(line), "%.3f %s\n", ms, aWhat);
+			}
+			Out += line;
+		}
+
+		std::string& Out;
+		int64_t      TicksPerSecond;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Replay:
+	/// 	Runs the frames of a trace through Activation::Step and its messages through Input::Router
+	/// 	as fast as possible and prints the resulting toggles, presses, releases and button ups, one
+	/// 	line each to aReplayed. If aRecorded is set, prints what the addon did during recording to it
+	/// 	in the same format. If aJumps is set, appends the recorded cursor resets to it. Binds held and
+	/// 	drags in progress when recording started are not known. Returns false if the trace is malformed.
+	///----------------------------------------------------------------------------------------------------
+	inline bool Replay(const std::vector<uint8_t>& aTrace, std::string& aReplayed, std::string* aRecorded = nullptr, std::vector<CursorJump>* aJumps = nullptr)
+	{
+		size_t   pos = 0;
+		uint64_t magic, version, ticksPerSecond, expiry, timeout, latency, wasActive, override, overrideAge, toggleAge, suspendUiState;
+
+		if (!ReadVarint(aTrace, pos, magic) || magic != TRACE_MAGIC ||
+			!ReadVarint(aTrace, pos, version) || version != TRACE_VERSION ||
+			!ReadVarint(aTrace, pos, ticksPerSecond) || ticksPerSecond == 0 ||
+			!ReadVarint(aTrace, pos, expiry) ||
+			!ReadVarint(aTrace, pos, timeout) ||
+			!ReadVarint(aTrace, pos, latency) ||
+			!ReadVarint(aTrace, pos, wasActive) ||
+			!ReadVarint(aTrace, pos, override) ||
+			!ReadVarint(aTrace, pos, overrideAge) ||
+			!ReadVarint(aTrace, pos, toggleAge) ||
+			!ReadVarint(aTrace, pos, suspendUiState))
+		{
+			return false;
+		}
+
+		Input::Settings settings{};
+		Input::Router   router;
+		if (!ReadSettings(aTrace, pos, settings))
+		{
+			return false;
+		}
+		router.Apply(settings, (int64_t)ticksPerSecond);
+
+		Activation::Rules rules{ (int)expiry, (int64_t)timeout, (int64_t)latency };
+		Activation::State state{};
+		state.WasActive         = wasActive != 0;
+		state.Override          = (uint32_t)(override & 0xFF);
+		state.OverrideCondition = (override >> 8) & 1;
+		state.OverrideSince     = -(int64_t)overrideAge;
+		state.ToggledAt         = -(int64_t)toggleAge;
+
+		std::string discard;
+		Printer     replayed(aReplayed, (int64_t)ticksPerSecond);
+		Printer     recorded(aRecorded ? *aRecorded : discard, (int64_t)ticksPerSecond);
+		Frame       frame{};
+		int64_t     now = 0;
+
+		/* Since the last frame that saw the cursor hidden, the start of the trace if none did yet. */
+		int64_t     hiddenAt      = 0;
+		uint32_t    visibleFrames = 0;
+
+		while (pos < aTrace.size())
+		{
+			ERecord  record = (ERecord)aTrace[pos++];
+			uint64_t delta;
+			if (!ReadVarint(aTrace, pos, delta))
+			{
+				return false;
+			}
+			now += (int64_t)delta;
+			replayed.Now = now;
+			recorded.Now = now;
+
+			switch (record)
+			{
+				case ERecord_Frame:
+				{
+					uint64_t flags;
+					if (!ReadVarint(aTrace, pos, flags) || pos >= aTrace.size())
+					{
+						return false;
+					}
+
+					frame.Flags     = (uint32_t)flags;
+					uint8_t changed = aTrace[pos++];
+					uint64_t value;
+					if (changed & EField_UiState)    { if (!ReadVarint(aTrace, pos, value)) { return false; } frame.UiState    = (uint32_t)value; }
+					if (changed & EField_MountIndex) { if (!ReadVarint(aTrace, pos, value)) { return false; } frame.MountIndex = (uint32_t)value; }
+					if (changed & EField_Distance)   { if (!ReadVarint(aTrace, pos, value)) { return false; } frame.Distance   = (uint32_t)value; }
+					if (changed & EField_Suspend)    { if (!ReadVarint(aTrace, pos, value)) { return false; } frame.Suspend    = (uint32_t)value; }
+					if (changed & EField_Context)    { if (!ReadVarint(aTrace, pos, value) || value > ERedirectContext_COUNT) { return false; } frame.Context = (uint32_t)value; }
+
+					if (frame.Flags & EFrame_IsCursorHidden)
+					{
+						hiddenAt      = now;
+						visibleFrames = 0;
+					}
+					else
+					{
+						visibleFrames++;
+					}
+
+					/* Same estimate as PreRender, with the drags the router derived from the replayed messages. */
+					bool gameplay  = (frame.Flags & EFrame_IsGameplay) != 0;
+					bool dragging  = router.IsDragging();
+					bool actionCam = gameplay && (frame.Flags & EFrame_IsCursorHidden) && !dragging;
+
+					/* Suspending UI states, e.g. a focused chat box, stop both evaluation and redirection. */
+					bool uiSuspended = gameplay && (frame.UiState & suspendUiState);
+
+					router.SetWantsMouse((frame.Flags & EFrame_WantsMouse) != 0);
+					router.SetActionCam(actionCam);
+					if (uiSuspended)
+					{
+						router.Suspend();
+					}
+					else if (frame.Context < ERedirectContext_COUNT)
+					{
+						router.SetContext((ERedirectContext)frame.Context);
+					}
+					else
+					{
+						router.Suspend();
+					}
+
+					if (gameplay && !uiSuspended && !dragging)
+					{
+						Activation::Frame input{};
+						input.CursorControlled = actionCam;
+						input.ShouldActivate   = (frame.Flags & EFrame_ShouldActivate) != 0;
+						input.Now              = now;
+
+						if (Activation::Step(state, input, rules) == Activation::EStep_Toggle)
+						{
+							replayed.Toggle();
+						}
+					}
+					break;
+				}
+				case ERecord_Message:
+				{
+					uint64_t msg, wParam, lParam, flags;
+					if (!ReadVarint(aTrace, pos, msg) || !ReadVarint(aTrace, pos, wParam) || !ReadVarint(aTrace, pos, lParam) || !ReadVarint(aTrace, pos, flags))
+					{
+						return false;
+					}
+
+					Input::Message message{};
+					message.Msg          = (uint32_t)msg;
+					message.WParam       = wParam;
+					message.LParam       = (int64_t)lParam;
+					message.Now          = now;
+					message.Alt          = (flags & EMessageFlag_Alt) != 0;
+					message.CursorHidden = (flags & EMessageFlag_CursorHidden) != 0;
+					message.Inhibited    = (flags & EMessageFlag_Inhibited) != 0;
+					router.Process(message, replayed);
+					break;
+				}
+				case ERecord_Toggle:
+				{
+					recorded.Toggle();
+					break;
+				}
+				case ERecord_Press:
+				case ERecord_Release:
+				case ERecord_ButtonUp:
+				{
+					uint64_t value;
+					if (!ReadVarint(aTrace, pos, value))
+					{
+						return false;
+					}
+
+					if (record == ERecord_Press)        { recorded.Press((Input::Bind)value); }
+					else if (record == ERecord_Release) { recorded.Release((Input::Bind)value); }
+					else                                { recorded.ButtonUp((uint32_t)value, 0, 0); }
+					break;
+				}
+				case ERecord_Override:
+				{
+					uint64_t value;
+					if (!ReadVarint(aTrace, pos, value))
+					{
+						return false;
+					}
+					state.Override          = (uint32_t)(value & 0xFF);
+					state.OverrideCondition = (value >> 8) & 1;
+					state.OverrideSince     = now;
+					break;
+				}
+				case ERecord_CursorReset:
+				{
+					uint64_t value;
+					if (!ReadVarint(aTrace, pos, value) || value > EResetFrom_Frame)
+					{
+						return false;
+					}
+
+					if (aJumps)
+					{
+						aJumps->push_back(CursorJump{ (now - hiddenAt) * 1000.0 / ticksPerSecond, visibleFrames, (EResetFrom)value });
+					}
+					break;
+				}
+				case ERecord_ClearActive:
+				{
+					/* A UI key dropped the addon's action cam, toggled right away if it was on. */
+					state.WasActive = false;
+					if (router.IsActionCam())
+					{
+						replayed.Toggle();
+					}
+					break;
+				}
+				default:
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+#endif
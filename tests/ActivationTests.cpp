@@ -0,0 +1,231 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  ActivationTests.cpp
+/// Description  :  Activation::Step state tests.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <utility>
+
+#include "Activation.h"
+#include "Test.h"
+
+static const Activation::Rules s_OnChange = { EOverrideExpiry_OnConditionChange, 0, 0 };
+
+static Activation::EStep StepFrame(Activation::State& aState, bool aCursorControlled, bool aShouldActivate, int64_t aNow = 0, const Activation::Rules& aRules = s_OnChange)
+{
+	Activation::Frame frame{ aCursorControlled, aShouldActivate, aNow };
+	return Activation::Step(aState, frame, aRules);
+}
+
+template <size_t... Flags>
+static constexpr std::array<bool (*)(const Activation::Conditions&), sizeof...(Flags)> MakeEvaluators(std::index_sequence<Flags...>)
+{
+	return { &Activation::ShouldActivate<Flags>... };
+}
+
+TEST(Activation, TurnsOnWhenConditionsAreMet)
+{
+	Activation::State state{};
+
+	CHECK(StepFrame(state, false, true) == Activation::EStep_Toggle);
+	CHECK(state.WasActive);
+
+	/* The game applied the toggle. */
+	CHECK(StepFrame(state, true, true) == Activation::EStep_None);
+	CHECK(state.WasActive);
+}
+
+TEST(Activation, TurnsOffWhatItTurnedOn)
+{
+	Activation::State state{};
+	state.WasActive = true;
+
+	CHECK(StepFrame(state, true, false) == Activation::EStep_Toggle);
+	CHECK(!state.WasActive);
+
+	CHECK(StepFrame(state, false, false) == Activation::EStep_None);
+}
+
+TEST(Activation, LeavesManualActionCamAlone)
+{
+	Activation::State state{};
+
+	CHECK(StepFrame(state, true, false) == Activation::EStep_None);
+	CHECK(!state.WasActive);
+}
+
+TEST(Activation, DoesNotFightActionCamLeftByOtherMeans)
+{
+	Activation::State state{};
+	state.WasActive = true;
+
+	/* E.g. a UI panel dropped action cam while the conditions still hold. */
+	CHECK(StepFrame(state, false, true) == Activation::EStep_None);
+	CHECK(state.WasActive);
+}
+
+TEST(Activation, TurnsOnAgainAfterActionCamWasLeftByOtherMeans)
+{
+	const Activation::Rules rules = { EOverrideExpiry_OnConditionChange, 0, 10 };
+
+	Activation::State state{};
+	CHECK(StepFrame(state, false, true, 0, rules) == Activation::EStep_Toggle);
+	CHECK(StepFrame(state, true, true, 5, rules) == Activation::EStep_None);
+
+	/* The game dropped action cam unseen, then the conditions ended. */
+	CHECK(StepFrame(state, false, true, 100, rules) == Activation::EStep_None);
+	CHECK(StepFrame(state, false, false, 200, rules) == Activation::EStep_None);
+	CHECK(!state.WasActive);
+
+	CHECK(StepFrame(state, false, true, 300, rules) == Activation::EStep_Toggle);
+}
+
+TEST(Activation, KeepsToggleTheGameHasNotAppliedYet)
+{
+	const Activation::Rules rules = { EOverrideExpiry_OnConditionChange, 0, 10 };
+
+	Activation::State state{};
+	CHECK(StepFrame(state, false, true, 0, rules) == Activation::EStep_Toggle);
+
+	/* The conditions ended before the game applied the toggle, it still has to be undone. */
+	CHECK(StepFrame(state, false, false, 5, rules) == Activation::EStep_None);
+	CHECK(state.WasActive);
+	CHECK(StepFrame(state, true, false, 8, rules) == Activation::EStep_Toggle);
+	CHECK(!state.WasActive);
+}
+
+TEST(Activation, OverrideExpiresOnConditionChange)
+{
+	Activation::State state{};
+	state.Override          = EOverride_ManualOff;
+	state.OverrideCondition = true;
+
+	CHECK(StepFrame(state, false, true) == Activation::EStep_Overridden);
+	CHECK(state.Override == EOverride_ManualOff);
+
+	/* The player stopped moving, the override ends and the player's choice is taken over. */
+	CHECK(StepFrame(state, false, false) == Activation::EStep_None);
+	CHECK(state.Override == EOverride_None);
+	CHECK(!state.WasActive);
+
+	/* And the next time the conditions are met the addon is in charge again. */
+	CHECK(StepFrame(state, false, true) == Activation::EStep_Toggle);
+}
+
+TEST(Activation, OverrideExpiryTakesOverManualOn)
+{
+	Activation::State state{};
+	state.Override          = EOverride_ManualOn;
+	state.OverrideCondition = false;
+
+	/* Expires on the frame the conditions are met, action cam is already on so there is nothing to do. */
+	CHECK(StepFrame(state, true, true) == Activation::EStep_None);
+	CHECK(state.Override == EOverride_None);
+	CHECK(state.WasActive);
+
+	/* Counted as turned on by the addon, so it is turned off with the conditions. */
+	CHECK(StepFrame(state, true, false) == Activation::EStep_Toggle);
+	CHECK(!state.WasActive);
+}
+
+TEST(Activation, OverrideExpiresAfterTimeout)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Timeout, 100, 0 };
+
+	Activation::State state{};
+	state.Override      = EOverride_ManualOff;
+	state.OverrideSince = 1000;
+
+	CHECK(StepFrame(state, false, true, 1050, rules) == Activation::EStep_Overridden);
+	CHECK(StepFrame(state, false, true, 1100, rules) == Activation::EStep_Overridden);
+
+	CHECK(StepFrame(state, false, true, 1101, rules) == Activation::EStep_Toggle);
+	CHECK(state.Override == EOverride_None);
+	CHECK(state.WasActive);
+}
+
+TEST(Activation, OverrideTimeoutIgnoresConditions)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Timeout, 100, 0 };
+
+	Activation::State state{};
+	state.Override          = EOverride_ManualOn;
+	state.OverrideCondition = false;
+
+	CHECK(StepFrame(state, true, true, 10, rules) == Activation::EStep_Overridden);
+	CHECK(StepFrame(state, true, false, 20, rules) == Activation::EStep_Overridden);
+}
+
+TEST(Activation, NeverOverrideOutlastsConditionsAndTime)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Never, 100, 0 };
+
+	Activation::State state{};
+	state.Override = EOverride_ManualOff;
+
+	CHECK(StepFrame(state, false, true, 0, rules) == Activation::EStep_Overridden);
+	CHECK(StepFrame(state, false, false, 1ll << 40, rules) == Activation::EStep_Overridden);
+	CHECK(StepFrame(state, false, true, 1ll << 41, rules) == Activation::EStep_Overridden);
+}
+
+TEST(Activation, SecondPressEndsNeverOverride)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Never, 100, 0 };
+
+	Activation::State state{};
+	state.Override = Activation::OverrideForPress(state.Override, EOverride_ManualOn, rules.OverrideExpiry);
+	CHECK(state.Override == EOverride_ManualOn);
+	CHECK(StepFrame(state, true, false, 10, rules) == Activation::EStep_Overridden);
+
+	/* The second press turns action cam off in game and hands control back. */
+	state.Override = Activation::OverrideForPress(state.Override, EOverride_ManualOff, rules.OverrideExpiry);
+	CHECK(state.Override == EOverride_Resume);
+
+	CHECK(StepFrame(state, false, false, 20, rules) == Activation::EStep_None);
+	CHECK(state.Override == EOverride_None);
+	CHECK(!state.WasActive);
+
+	CHECK(StepFrame(state, false, true, 30, rules) == Activation::EStep_Toggle);
+	CHECK(state.WasActive);
+
+	/* The next press starts a new override. */
+	state.Override = Activation::OverrideForPress(state.Override, EOverride_ManualOff, rules.OverrideExpiry);
+	CHECK(state.Override == EOverride_ManualOff);
+}
+
+TEST(Activation, PressesRestartExpiringOverrides)
+{
+	CHECK(Activation::OverrideForPress(EOverride_ManualOn, EOverride_ManualOff, EOverrideExpiry_OnConditionChange) == EOverride_ManualOff);
+	CHECK(Activation::OverrideForPress(EOverride_ManualOff, EOverride_ManualOn, EOverrideExpiry_Timeout) == EOverride_ManualOn);
+	CHECK(Activation::OverrideForPress(EOverride_Resume, EOverride_ManualOn, EOverrideExpiry_Never) == EOverride_ManualOn);
+}
+
+TEST(Activation, HandlesTicksNearOverflow)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Timeout, 100, 0 };
+	const int64_t           start = INT64_MAX - 150;
+
+	Activation::State state{};
+	state.Override      = EOverride_ManualOff;
+	state.OverrideSince = start;
+
+	CHECK(StepFrame(state, false, true, start + 100, rules) == Activation::EStep_Overridden);
+	CHECK(StepFrame(state, false, true, start + 101, rules) == Activation::EStep_Toggle);
+}
+
+TEST(Activation, SpecializedEvaluatorsMatchTheSettings)
+{
+	const std::array<bool (*)(const Activation::Conditions&), EActivation_COUNT> evaluators = MakeEvaluators(std::make_index_sequence<EActivation_COUNT>{});
+
+	for (uint32_t flags = 0; flags < EActivation_COUNT; flags++)
+	{
+		for (uint32_t bits = 0; bits < 16; bits++)
+		{
+			const Activation::Conditions conditions = { (bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0, (bits & 8) != 0 };
+			CHECK(evaluators[flags](conditions) == Activation::ShouldActivate(flags, conditions));
+		}
+	}
+}
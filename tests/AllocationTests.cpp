@@ -0,0 +1,266 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  AllocationTests.cpp
+/// Description  :  Asserts the per-frame and per-message paths never allocate.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "Core.h"
+#include "Fakes.h"
+#include "GameBinds.h"
+#include "Profiler.h"
+#include "Shared.h"
+#include "Test.h"
+
+using namespace Input;
+
+static_assert(Profiler::TracksAllocations, "The tests are built with MLH_TRACK_ALLOCATIONS.");
+
+static constexpr int FRAMES = 100000;
+
+/* Keeps what the hook test allocates observable, so the optimizer cannot drop the calls. */
+static void* volatile s_Kept = nullptr;
+
+///----------------------------------------------------------------------------------------------------
+/// CountingOutput:
+/// 	Stands in for the game without allocating, unlike FakeOutput. A repeated press of a held bind
+/// 	is a key repeat, one release lets go of it.
+///----------------------------------------------------------------------------------------------------
+struct CountingOutput : Core::GameProvider
+{
+	void Press(Bind aBind)                     override { Down[aBind & 1023] = true; }
+	void Release(Bind aBind)                   override { Down[aBind & 1023] = false; }
+	void ButtonUp(uint32_t, uint64_t, int64_t) override {}
+	void ToggleActionCam(bool)                 override { Toggles++; ActionCam = !ActionCam; }
+
+	int Held() const
+	{
+		int held = 0;
+		for (bool down : Down)
+		{
+			held += down ? 1 : 0;
+		}
+		return held;
+	}
+
+	bool Down[1024] = {};
+	int  Toggles    = 0;
+	bool ActionCam  = false;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// Player:
+/// 	A handler on the counting game and fakes of the other providers, with redirects, a chord,
+/// 	a remap and a UI key set up.
+///----------------------------------------------------------------------------------------------------
+struct Player
+{
+	Player()
+	{
+		Core::Config config{};
+		config.ResetToCenter  = true;
+		config.EnableInCombat = true;
+		config.EnableOnMount  = true;
+		config.RedirectLMB   = true;
+		config.RedirectRMB   = true;
+		config.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = 10;
+		config.RedirectTarget[ERedirectContext_Default][ERedirectButton_RMB] = 11;
+		config.RedirectOverride[ERedirectContext_Combat][ERedirectButton_LMB] = true;
+		config.RedirectTarget[ERedirectContext_Combat][ERedirectButton_LMB]   = 20;
+		config.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Shift] = true;
+		config.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Shift]   = 30;
+		config.Chord         = true;
+		config.ChordTarget   = 40;
+		config.ChordWindowMs = 50;
+		config.RemapKeys     = true;
+		config.KeyRemap['Q']       = true;
+		config.KeyRemapTarget['Q'] = 50;
+		config.ExitOnUiKeys  = true;
+		config.UiKey['M']    = true;
+
+		/* Settings are applied while loading, which may allocate. */
+		Shared.Version.store(MLH_STATE_VERSION, std::memory_order_relaxed);
+		Handler.Start(&Shared, &Inhibit);
+		Handler.Apply(config);
+	}
+
+	/* What PreRender sees, a player who moves, fights, mounts and opens the map now and then. */
+	void Frame(int aFrame)
+	{
+		Link.Data.IsMoving   = (aFrame / 60) % 3 != 0;
+		Link.Data.MountIndex = (aFrame / 3000) % 4 == 3 ? 1 : 0;
+		Link.Data.UiState    = ((aFrame / 600) % 2 ? EUiState_InCombat : EUiState_None)
+		                     | ((aFrame / 700) % 5 == 4 ? EUiState_MapOpen : EUiState_None);
+		Link.CameraMoving.store(aFrame % 90 < 10, std::memory_order_relaxed);
+		Clock.Advance(16);
+
+		Handler.Frame(aFrame % 500 < 20, aFrame % 1300 < 15);
+
+		/* The game applies a toggle by the next frame, the cursor hides in action cam. */
+		Cursor.Hidden.store(Game.ActionCam, std::memory_order_relaxed);
+	}
+
+	/* What WndProc sees between two frames: clicks, chords, drags, remapped and UI keys, moves. */
+	void Messages(int aFrame)
+	{
+		switch (aFrame % 8)
+		{
+			case 0:
+				Process(EMessage_LButtonDown, EMouseKey_LButton, 0);
+				Process(EMessage_LButtonUp, 0, 5);
+				break;
+			case 1:
+				Process(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_Shift, 0);
+				Process(EMessage_LButtonDblClk, EMouseKey_LButton | EMouseKey_Shift, 2);
+				Process(EMessage_LButtonUp, 0, 3);
+				break;
+			case 2:
+				Process(EMessage_RButtonDown, EMouseKey_RButton, 0);
+				Process(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_RButton, 10);
+				Process(EMessage_LButtonUp, EMouseKey_RButton, 2);
+				Process(EMessage_RButtonUp, 0, 2);
+				break;
+			case 3:
+			{
+				/* A camera drag: the button goes down on a visible cursor, which hides while it is held. */
+				bool hidden = Cursor.Hidden.load(std::memory_order_relaxed);
+				Cursor.Hidden.store(false, std::memory_order_relaxed);
+				Process(EMessage_RButtonDown, EMouseKey_RButton, 0);
+				Cursor.Hidden.store(true, std::memory_order_relaxed);
+				Process(EMessage_MouseMove, EMouseKey_RButton, 5);
+				Process(EMessage_MouseMove, 0, 5);
+				Cursor.Hidden.store(hidden, std::memory_order_relaxed);
+				break;
+			}
+			case 4:
+				Process(EMessage_KeyDown, 'Q', 0);
+				Process(EMessage_KeyUp, 'Q', 5);
+				break;
+			case 5:
+				Process(EMessage_KeyDown, 'M', 0);
+				Process(EMessage_KeyUp, 'M', 5);
+				break;
+			case 6:
+				Process(EMessage_SetCursor, 0, 0);
+				break;
+			default:
+				Process(EMessage_MouseMove, 0, 0);
+				break;
+		}
+
+		if (aFrame % 1000 == 999)
+		{
+			Process(EMessage_KeyDown, 0x1B, 0);
+			Process(EMessage_KeyUp, 0x1B, 5);
+		}
+	}
+
+	void Process(uint32_t aMsg, uint64_t aWParam, int64_t aAfter)
+	{
+		Clock.Advance(aAfter);
+		Handler.Process(MakeMessage(aMsg, aWParam, Clock.Now()));
+	}
+
+	CountingOutput                   Game;
+	FakeCursor                       Cursor;
+	FakeWindow                       Window;
+	FakeLink                         Link;
+	FakeClock                        Clock;
+	MouseLookHandler::SharedState    Shared  = {};
+	MouseLookHandler::InhibitChannel Inhibit = {};
+	Core::Handler                    Handler{ Game, Cursor, Window, Link, Clock };
+};
+
+TEST(Allocations, HookCountsThisThread)
+{
+	uint64_t allocations = Profiler::Allocations();
+
+	/* Called directly rather than through new expressions, whose allocations may be elided. */
+	s_Kept = ::operator new(64);
+	::operator delete(s_Kept);
+	s_Kept = ::operator new[](64);
+	::operator delete[](s_Kept);
+	CHECK(Profiler::Allocations() - allocations == 2);
+
+	{
+		Profiler::Exempt exempt;
+		s_Kept = ::operator new(64);
+		::operator delete(s_Kept);
+	}
+	CHECK(Profiler::Allocations() - allocations == 2);
+}
+
+TEST(Allocations, FramesAndMessagesNeverAllocate)
+{
+	constexpr int gameBinds = (int)(sizeof(GameBinds::Entries) / sizeof(GameBinds::Entries[0]));
+
+	Player        player;
+	FakeOptionsUi ui;
+	Bind          target    = EGameBinds_CameraActionMode;
+	int           selectors = 0;
+
+	Profiler::SetEnabled(true);
+	uint64_t allocations = Profiler::Allocations();
+
+	for (int frame = 0; frame < FRAMES; frame++)
+	{
+		{
+			Profiler::Scope profile(Profiler::EEntry_PreRender);
+			player.Frame(frame);
+		}
+
+		{
+			Profiler::Scope profile(Profiler::EEntry_WndProc);
+			player.Messages(frame);
+		}
+
+		/* The options window, while it is open. */
+		GameBinds::ToString(GameBinds::Entries[frame % gameBinds].Bind);
+		if (frame % 60 == 0)
+		{
+			GameBinds::Selector(ui, "##Target", &target);
+			selectors++;
+		}
+	}
+
+	CHECK(Profiler::Allocations() == allocations);
+	CHECK(Profiler::Get(Profiler::EEntry_PreRender).Calls.load() == FRAMES);
+	CHECK(Profiler::Get(Profiler::EEntry_PreRender).Violations.load() == 0);
+	CHECK(Profiler::Get(Profiler::EEntry_WndProc).Violations.load() == 0);
+	CHECK(Profiler::Get(Profiler::EEntry_GameBindToString).Allocations.load() == 0);
+	CHECK(Profiler::Get(Profiler::EEntry_GbSelector).Calls.load() == (uint64_t)selectors);
+	CHECK(Profiler::Get(Profiler::EEntry_GbSelector).Allocations.load() == 0);
+	CHECK(ui.Selectables == selectors * gameBinds);
+	CHECK(player.Game.Toggles > 0);
+	CHECK(player.Game.Held() == 0);
+	CHECK(player.Handler.GetRouter().Held() == 0);
+
+	Profiler::SetEnabled(false);
+	player.Handler.Stop();
+}
+
+TEST(Allocations, RecordingIsExempt)
+{
+	Player player;
+
+	/* Starting a recording allocates the buffer, as in the addon it happens from the options. */
+	player.Handler.StartRecording();
+
+	uint64_t allocations = Profiler::Allocations();
+
+	for (int frame = 0; frame < FRAMES; frame++)
+	{
+		player.Frame(frame);
+		player.Messages(frame);
+	}
+
+	CHECK(Profiler::Allocations() == allocations);
+
+	std::vector<uint8_t> trace = player.Handler.StopRecording();
+	CHECK(trace.size() > (size_t)FRAMES);
+
+	player.Handler.Stop();
+}
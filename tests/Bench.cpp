@@ -0,0 +1,396 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Bench.cpp
+/// Description  :  Measures the per-frame, per-message, settings and options paths outside the game.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "Activation.h"
+#include "Core.h"
+#include "Fakes.h"
+#include "GameBinds.h"
+#include "Input.h"
+#include "Profiler.h"
+#include "Shared.h"
+#include "Trace.h"
+
+using json = nlohmann::json;
+
+typedef bool (*ACTIVATION_EVALUATOR)(const Activation::Conditions& aConditions);
+
+static constexpr int64_t TPS = 1000; /* Ticks are milliseconds. */
+
+static volatile bool     s_Sink  = false;
+static volatile uint32_t s_Flags = EActivation_WhileMoving | EActivation_OnMount;
+
+///----------------------------------------------------------------------------------------------------
+/// CountingGame:
+/// 	Stands in for the game without allocating, so only the handler's own allocations are counted.
+///----------------------------------------------------------------------------------------------------
+struct CountingGame : Core::GameProvider
+{
+	void Press(Input::Bind)                    override { Presses++; }
+	void Release(Input::Bind)                  override { Releases++; }
+	void ButtonUp(uint32_t, uint64_t, int64_t) override { ButtonUps++; }
+	void ToggleActionCam(bool)                 override { ActionCam = !ActionCam; }
+
+	uint64_t Presses   = 0;
+	uint64_t Releases  = 0;
+	uint64_t ButtonUps = 0;
+	bool     ActionCam = false;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// Result:
+/// 	One measured path.
+///----------------------------------------------------------------------------------------------------
+struct Result
+{
+	const char* Name;
+	uint64_t    Iterations;
+	double      NsPerOp;
+	double      AllocationsPerOp;
+};
+
+static std::vector<Result> s_Results;
+
+///----------------------------------------------------------------------------------------------------
+/// MakeActivationEvaluators:
+/// 	The table the addon selects from when the settings change.
+///----------------------------------------------------------------------------------------------------
+template <size_t... Flags>
+static constexpr std::array<ACTIVATION_EVALUATOR, sizeof...(Flags)> MakeActivationEvaluators(std::index_sequence<Flags...>)
+{
+	return { &Activation::ShouldActivate<Flags>... };
+}
+
+static constexpr std::array<ACTIVATION_EVALUATOR, EActivation_COUNT> s_ActivationEvaluators = MakeActivationEvaluators(std::make_index_sequence<EActivation_COUNT>{});
+
+///----------------------------------------------------------------------------------------------------
+/// ShouldActivateBranchy:
+/// 	The evaluator before it was specialized, reading the settings every call.
+///----------------------------------------------------------------------------------------------------
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+static bool ShouldActivateBranchy(const Activation::Conditions& aConditions)
+{
+	return Activation::ShouldActivate(s_Flags, aConditions);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// Measure:
+/// 	Calls aBody(i) aIterations times and records the time and allocations per call.
+///----------------------------------------------------------------------------------------------------
+template <typename Body>
+static void Measure(const char* aName, uint64_t aIterations, Body&& aBody)
+{
+	if (aIterations == 0)
+	{
+		aIterations = 1;
+	}
+
+	uint64_t allocations = Profiler::Allocations();
+	auto     start       = std::chrono::steady_clock::now();
+
+	for (uint64_t i = 0; i < aIterations; i++)
+	{
+		aBody(i);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	allocations = Profiler::Allocations() - allocations;
+
+	Result result{};
+	result.Name             = aName;
+	result.Iterations       = aIterations;
+	result.NsPerOp          = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / aIterations;
+	result.AllocationsPerOp = (double)allocations / aIterations;
+
+	printf("%-24s %10.2f ns/op %8.3f allocs/op\n", result.Name, result.NsPerOp, result.AllocationsPerOp);
+	s_Results.push_back(result);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// MakeConfig:
+/// 	A player who redirects both buttons, has combat and shift overrides, a chord and a few remaps.
+///----------------------------------------------------------------------------------------------------
+static Core::Config MakeConfig()
+{
+	Core::Config config{};
+	config.EnableOnMount = true;
+	config.RedirectLMB   = true;
+	config.RedirectRMB   = true;
+	config.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = 10;
+	config.RedirectTarget[ERedirectContext_Default][ERedirectButton_RMB] = 11;
+	config.RedirectOverride[ERedirectContext_Combat][ERedirectButton_LMB] = true;
+	config.RedirectTarget[ERedirectContext_Combat][ERedirectButton_LMB]   = 20;
+	config.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Shift] = true;
+	config.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Shift]   = 30;
+	config.Chord         = true;
+	config.ChordTarget   = 40;
+	config.ChordWindowMs = 50;
+	config.RemapKeys     = true;
+	for (int vk = '1'; vk <= '5'; vk++)
+	{
+		config.KeyRemap[vk]       = true;
+		config.KeyRemapTarget[vk] = 50 + vk;
+	}
+	config.ExitOnUiKeys = true;
+	config.UiKey['M']   = true;
+	config.UiKey['I']   = true;
+	return config;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// WriteResults:
+/// 	Writes the results as JSON, in the shape of the profiler's export.
+///----------------------------------------------------------------------------------------------------
+static bool WriteResults(const char* aPath)
+{
+	json results = json::object();
+
+	for (const Result& result : s_Results)
+	{
+		results["entries"][result.Name] = {
+			{ "calls",              result.Iterations },
+			{ "ns_per_op",          result.NsPerOp },
+			{ "allocations_per_op", result.AllocationsPerOp }
+		};
+	}
+
+	std::ofstream file(aPath);
+	file << results.dump(1, '\t') << std::endl;
+	return file.good();
+}
+
+int main(int argc, char** argv)
+{
+	uint64_t iterations = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+	if (iterations == 0)
+	{
+		fprintf(stderr, "usage: %s [iterations] [results.json]\n"
+		                "Settings and options paths run iterations / 1000 times.\n", argv[0]);
+		return 1;
+	}
+
+	/* Random snapshots, so no path is helped by a predictable pattern. */
+	std::vector<Activation::Conditions> conditions(4096);
+	uint32_t seed = 0x5EED;
+	for (Activation::Conditions& c : conditions)
+	{
+		seed = seed * 1664525 + 1013904223;
+		c = { (seed & (1 << 28)) != 0, (seed & (1 << 29)) != 0, (seed & (1 << 30)) != 0, (seed & (1u << 31)) != 0 };
+	}
+	const size_t mask = conditions.size() - 1;
+
+	/* PreRender */
+	ACTIVATION_EVALUATOR specialized = s_ActivationEvaluators[s_Flags];
+	ACTIVATION_EVALUATOR branchy     = &ShouldActivateBranchy;
+
+	Measure("evaluator/branchy", iterations, [&](uint64_t i) { s_Sink = branchy(conditions[i & mask]); });
+	Measure("evaluator/specialized", iterations, [&](uint64_t i) { s_Sink = specialized(conditions[i & mask]); });
+
+	const Activation::Rules rules = { EOverrideExpiry_OnConditionChange, 0, 0 };
+	Activation::State       state{};
+	Measure("prerender/step", iterations, [&](uint64_t i)
+	{
+		/* The game applies a toggle by the next frame. */
+		Activation::Frame frame{ state.WasActive, specialized(conditions[i & mask]), (int64_t)i * 16 };
+		s_Sink = Activation::Step(state, frame, rules) == Activation::EStep_Toggle;
+	});
+
+	MouseLookHandler::SharedState shared{};
+	Measure("prerender/publish", iterations, [&](uint64_t i)
+	{
+		MouseLookHandler::Write(&shared, i & 1, MouseLookHandler::EProfile_Default, 0);
+	});
+
+	/* Recording writes to a buffer that was grown once, as in a session that records for a while. */
+	Trace::Writer trace;
+	trace.Begin(TPS, rules, state, Input::Settings{}, 0, 0);
+	trace.Buffer.reserve(1 << 20);
+	Measure("prerender/trace", iterations, [&](uint64_t i)
+	{
+		if (trace.Buffer.size() > (1 << 20) - 64)
+		{
+			trace.Buffer.resize(64);
+		}
+
+		Trace::Frame frame{};
+		frame.Flags    = (uint32_t)(i & 7);
+		frame.UiState  = (uint32_t)((i >> 6) & 1);
+		frame.Distance = 400 + (uint32_t)(i & 3);
+		trace.WriteFrame((int64_t)i * 16, frame);
+	});
+
+	/* The handler behind PreRender and WndProc, on a player who moves in and out of action cam. */
+	CountingGame game;
+	FakeCursor   cursor;
+	FakeWindow   window;
+	FakeLink     link;
+	FakeClock    clock;
+
+	Core::Handler handler(game, cursor, window, link, clock);
+	handler.Start(&shared, nullptr);
+	handler.Apply(MakeConfig());
+
+	Measure("prerender/frame", iterations, [&](uint64_t i)
+	{
+		const Activation::Conditions& c = conditions[i & mask];
+		link.Data.IsMoving   = c.IsMoving;
+		link.Data.MountIndex = c.IsMounted;
+		clock.Advance(16);
+		handler.Frame(false, false);
+
+		/* The game applies a toggle by the next frame, the cursor hides in action cam. */
+		cursor.Hidden.store(game.ActionCam, std::memory_order_relaxed);
+	});
+
+	/* Redirects and remaps apply in action cam. */
+	link.Data.IsMoving   = true;
+	link.Data.MountIndex = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		clock.Advance(16);
+		handler.Frame(false, false);
+		cursor.Hidden.store(game.ActionCam, std::memory_order_relaxed);
+	}
+
+	Measure("wndproc/redirect", iterations, [&](uint64_t i)
+	{
+		clock.Advance(100);
+		if (i & 1)
+		{
+			handler.Process(MakeMessage(Input::EMessage_LButtonUp, 0));
+		}
+		else
+		{
+			handler.Process(MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton));
+		}
+	});
+
+	Measure("wndproc/chord", iterations, [&](uint64_t i)
+	{
+		switch (i & 3)
+		{
+			case 0: clock.Advance(140); handler.Process(MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton)); break;
+			case 1: clock.Advance(10);  handler.Process(MakeMessage(Input::EMessage_RButtonDown, Input::EMouseKey_LButton | Input::EMouseKey_RButton)); break;
+			case 2: clock.Advance(10);  handler.Process(MakeMessage(Input::EMessage_RButtonUp, Input::EMouseKey_LButton)); break;
+			case 3: clock.Advance(10);  handler.Process(MakeMessage(Input::EMessage_LButtonUp, 0)); break;
+		}
+	});
+
+	Measure("wndproc/remap", iterations, [&](uint64_t i)
+	{
+		handler.Process(MakeMessage(i & 1 ? Input::EMessage_KeyUp : Input::EMessage_KeyDown, '1' + (i >> 1) % 5));
+	});
+
+	Measure("wndproc/mousemove", iterations, [&](uint64_t)
+	{
+		handler.Process(MakeMessage(Input::EMessage_MouseMove, 0));
+	});
+
+	Measure("wndproc/trace", iterations, [&](uint64_t i)
+	{
+		if (trace.Buffer.size() > (1 << 20) - 64)
+		{
+			trace.Buffer.resize(64);
+		}
+
+		trace.WriteMessage((int64_t)i, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton, (int64_t)i));
+	});
+
+	/* Settings */
+	const Core::Config config = MakeConfig();
+	const std::string  text   = Core::SerializeSettings(config);
+	const std::string  path   = "mlh_bench_settings.json";
+
+	Measure("settings/apply", iterations / 1000, [&](uint64_t)
+	{
+		handler.Apply(config);
+	});
+
+	Measure("settings/serialize", iterations / 1000, [&](uint64_t)
+	{
+		s_Sink = Core::SerializeSettings(config).empty();
+	});
+
+	Measure("settings/deserialize", iterations / 1000, [&](uint64_t)
+	{
+		Core::Config loaded{};
+		s_Sink = Core::DeserializeSettings(text, loaded) == Core::ESettings_Loaded;
+	});
+
+	Measure("settings/save", iterations / 1000, [&](uint64_t)
+	{
+		s_Sink = Core::SaveSettings(path, config);
+	});
+
+	Measure("settings/load", iterations / 1000, [&](uint64_t)
+	{
+		Core::Config loaded{};
+		s_Sink = Core::LoadSettings(path, loaded) == Core::ESettings_Loaded;
+		handler.Apply(loaded);
+	});
+
+	std::remove(path.c_str());
+
+	/* Options */
+	constexpr size_t gameBinds = sizeof(GameBinds::Entries) / sizeof(GameBinds::Entries[0]);
+
+	Measure("options/gamebindtostring", iterations, [&](uint64_t i)
+	{
+		s_Sink = *GameBinds::ToString(GameBinds::Entries[i % gameBinds].Bind) != 0;
+	});
+
+	FakeOptionsUi ui;
+	Input::Bind   target = EGameBinds_CameraActionMode;
+	Measure("options/gbselector", iterations / 1000, [&](uint64_t)
+	{
+		GameBinds::Selector(ui, "##Target", &target);
+	});
+
+	handler.Stop();
+
+	if (game.Presses == 0)
+	{
+		fprintf(stderr, "The handler never redirected, action cam did not come on.\n");
+		return 2;
+	}
+
+	if (game.Presses != game.Releases)
+	{
+		fprintf(stderr, "%llu presses but %llu releases.\n", (unsigned long long)game.Presses, (unsigned long long)game.Releases);
+		return 2;
+	}
+
+	if ((size_t)ui.Selectables != gameBinds * std::max<uint64_t>(iterations / 1000, 1))
+	{
+		fprintf(stderr, "The selector offered %d of %zu game binds.\n", ui.Selectables, gameBinds);
+		return 2;
+	}
+
+	if (argc > 2 && !WriteResults(argv[2]))
+	{
+		fprintf(stderr, "%s could not be written.\n", argv[2]);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,356 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  CoreTests.cpp
+/// Description  :  Core::Handler frame and message tests against fake providers, and settings tests.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "Core.h"
+#include "Fakes.h"
+#include "Test.h"
+#include "Trace.h"
+
+using namespace MouseLookHandler;
+
+static constexpr uint32_t VK_I   = 'I';
+static constexpr uint32_t VK_CAM = 'V';
+
+TEST(Core, SettingsRoundTrip)
+{
+	Core::Config config{};
+	config.RestoreCursor      = true;
+	config.EnableInCombat     = true;
+	config.ZoomInDistance     = 2.5f;
+	config.SuspendUiState     = EUiState_MapOpen;
+	config.RedirectLMB        = true;
+	config.RedirectOverride[ERedirectContext_Mount][ERedirectButton_RMB]         = true;
+	config.RedirectTarget[ERedirectContext_Mount][ERedirectButton_RMB]           = 42;
+	config.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Ctrl] = true;
+	config.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Ctrl]   = 43;
+	config.ChordTarget        = 44;
+	config.KeyRemap['Q']       = true;
+	config.KeyRemapTarget['Q'] = 45;
+	config.ActionCamKey       = VK_CAM;
+	config.OverrideExpiry     = EOverrideExpiry_Never;
+	config.UiKey[VK_I]        = true;
+
+	Core::Config loaded{};
+	CHECK(Core::DeserializeSettings(Core::SerializeSettings(config), loaded) == Core::ESettings_Loaded);
+
+	CHECK(loaded.RestoreCursor && loaded.EnableInCombat && loaded.EnableWhileMoving);
+	CHECK(loaded.ZoomInDistance == 2.5f);
+	CHECK(loaded.SuspendUiState == EUiState_MapOpen);
+	CHECK(loaded.RedirectLMB && !loaded.RedirectRMB);
+	CHECK(loaded.RedirectOverride[ERedirectContext_Default][ERedirectButton_LMB]);
+	CHECK(loaded.RedirectOverride[ERedirectContext_Mount][ERedirectButton_RMB]);
+	CHECK(loaded.RedirectTarget[ERedirectContext_Mount][ERedirectButton_RMB] == 42);
+	CHECK(loaded.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Ctrl] == 43);
+	CHECK(loaded.ChordTarget == 44);
+	CHECK(loaded.KeyRemap['Q'] && loaded.KeyRemapTarget['Q'] == 45 && !loaded.KeyRemap['E']);
+	CHECK(loaded.ActionCamKey == (int)VK_CAM);
+	CHECK(loaded.OverrideExpiry == EOverrideExpiry_Never);
+	CHECK(loaded.UiKey[VK_I] && !loaded.UiKey['M']);
+}
+
+TEST(Core, MalformedSettingsFallBackToDefaults)
+{
+	const Core::Config defaults{};
+
+	for (const char* text : { "{ \"ENABLE_ON_MOUNT\": tru", "[ 1, 2 ]", "{ \"CHORD_WINDOW_MS\": \"fast\" }" })
+	{
+		Core::Config config{};
+		config.EnableOnMount = true;
+		config.UiKey[VK_I]   = true;
+
+		std::string error;
+		CHECK(Core::DeserializeSettings(text, config, &error) == Core::ESettings_Malformed);
+		CHECK(!error.empty());
+		CHECK(memcmp(config.UiKey, defaults.UiKey, sizeof(defaults.UiKey)) == 0);
+		CHECK(config.EnableOnMount == defaults.EnableOnMount && config.ChordWindowMs == defaults.ChordWindowMs);
+	}
+}
+
+TEST(Core, OldRedirectSettingsAreReported)
+{
+	Core::Config config{};
+	CHECK(Core::DeserializeSettings("{ \"LC_KEY\": 2, \"ENABLE_ON_MOUNT\": true }", config) == Core::ESettings_Migrated);
+	CHECK(config.EnableOnMount);
+	CHECK(Core::DeserializeSettings("{ \"LC_KEY\": 0 }", config) == Core::ESettings_Loaded);
+	CHECK(!config.EnableOnMount);
+}
+
+TEST(Core, TogglesWhileMoving)
+{
+	FakeRig rig;
+
+	State state = rig.Frame();
+	CHECK(rig.Game.Toggles == 0);
+	CHECK(!state.IsActionCam && state.Suspend == ESuspend_None);
+
+	rig.Link.Data.IsMoving = true;
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 1 && rig.Game.ImmediateToggles == 0);
+	CHECK(rig.Handler.IsActive());
+
+	rig.ApplyToggles();
+	state = rig.Frame();
+	CHECK(rig.Game.Toggles == 1);
+	CHECK(state.IsActionCam);
+
+	rig.Link.Data.IsMoving = false;
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 2 && !rig.Game.ActionCam);
+	CHECK(!rig.Handler.IsActive());
+}
+
+TEST(Core, PublishesSuspendReasons)
+{
+	FakeRig rig;
+	rig.Link.Data.IsMoving = true;
+
+	rig.Link.Data.IsGameplay = false;
+	CHECK(rig.Frame().Suspend == ESuspend_NotGameplay);
+
+	rig.Link.Data.IsGameplay = true;
+	rig.Link.Data.UiState    = EUiState_MapOpen;
+	CHECK(rig.Frame().Suspend == ESuspend_UiState);
+	CHECK(rig.Game.Toggles == 0);
+
+	rig.Link.Data.UiState = EUiState_None;
+	rig.Handler.SetHoldSuspended(true);
+	CHECK(rig.Frame().Suspend == ESuspend_Hold);
+
+	rig.Handler.SetHoldSuspended(false);
+	rig.Inhibit.Inhibit.store(1);
+	CHECK(rig.Frame().Suspend == ESuspend_Inhibit);
+	CHECK(rig.Game.Toggles == 0);
+
+	rig.Inhibit.Inhibit.store(0);
+	rig.Link.Data.MountIndex = 1;
+	State state = rig.Frame();
+	CHECK(state.Suspend == ESuspend_None && state.Profile == EProfile_Mount);
+	CHECK(rig.Game.Toggles == 1);
+}
+
+TEST(Core, UiKeyLeavesActionCamBeforeThePanelOpens)
+{
+	Core::Config config{};
+	config.ExitOnUiKeys = true;
+	config.UiKey[VK_I]  = true;
+
+	FakeRig rig(config);
+	rig.Link.Data.IsMoving = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 1 && rig.Game.ActionCam);
+
+	rig.Handler.Process(MakeMessage(Input::EMessage_KeyDown, VK_I));
+	CHECK(rig.Game.Toggles == 2 && rig.Game.ImmediateToggles == 1);
+	CHECK(!rig.Handler.IsActive());
+
+	/* Still moving, but the panel keeps action cam off until it is closed again. */
+	rig.ApplyToggles();
+	CHECK(rig.Frame().Suspend == ESuspend_UiKey);
+	CHECK(rig.Game.Toggles == 2);
+
+	rig.Handler.Process(MakeMessage(Input::EMessage_KeyDown, 0x1B));
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 3 && rig.Game.ActionCam);
+}
+
+TEST(Core, UiKeyAndConditionChangeInTheSameFrameToggleOnce)
+{
+	Core::Config config{};
+	config.ExitOnUiKeys = true;
+	config.UiKey[VK_I]  = true;
+
+	FakeRig rig(config);
+	rig.Link.Data.IsMoving = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 1 && rig.Game.ActionCam);
+
+	/* The player stops and opens the inventory while the frame that sees them stop is being evaluated. */
+	rig.Link.Data.IsMoving = false;
+	rig.Link.OnRead = [&rig]()
+	{
+		rig.Link.OnRead = nullptr;
+		rig.Handler.Process(MakeMessage(Input::EMessage_KeyDown, VK_I));
+	};
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 2 && rig.Game.ImmediateToggles == 1);
+	CHECK(!rig.Handler.IsActive());
+
+	rig.ApplyToggles();
+	rig.Frame();
+	rig.Frame();
+	CHECK(rig.Game.Toggles == 2 && !rig.Game.ActionCam);
+}
+
+TEST(Core, CameraDragIsNotActionCam)
+{
+	FakeRig rig;
+	rig.Frame();
+
+	/* The button goes down on a visible cursor, the game hides it while the camera is dragged. */
+	rig.Handler.Process(MakeMessage(Input::EMessage_RButtonDown, Input::EMouseKey_RButton));
+	rig.Cursor.Hidden      = true;
+	rig.Link.Data.IsMoving = true;
+
+	State state = rig.Frame();
+	CHECK(state.Suspend == ESuspend_Dragging && !state.IsActionCam);
+	CHECK(rig.Frame().Suspend == ESuspend_Dragging);
+	CHECK(rig.Game.Toggles == 0);
+
+	/* Released, the cursor shows again and the conditions apply from the next frame on. */
+	rig.Handler.Process(MakeMessage(Input::EMessage_RButtonUp, 0));
+	rig.Cursor.Hidden = false;
+
+	state = rig.Frame();
+	CHECK(state.Suspend == ESuspend_None && !state.IsActionCam);
+	CHECK(rig.Game.Toggles == 1);
+
+	rig.ApplyToggles();
+	state = rig.Frame();
+	CHECK(state.Suspend == ESuspend_None && state.IsActionCam);
+	CHECK(rig.Game.Toggles == 1);
+}
+
+TEST(Core, ActionCamKeyOverridesUntilConditionsChange)
+{
+	Core::Config config{};
+	config.ActionCamKey = VK_CAM;
+
+	FakeRig rig(config);
+	rig.Link.Data.IsMoving = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Frame();
+
+	/* The addon's own toggle comes back through the message loop and is not an override. */
+	rig.Handler.Process(MakeMessage(Input::EMessage_KeyDown, VK_CAM));
+	CHECK(rig.Frame().Suspend == ESuspend_None);
+
+	rig.Clock.Advance(1000);
+	rig.Handler.Process(MakeMessage(Input::EMessage_KeyDown, VK_CAM));
+	rig.Game.ToggleActionCam(false);
+	rig.ApplyToggles();
+	CHECK(rig.Frame().Suspend == ESuspend_ManualOverride);
+	CHECK(rig.Game.Toggles == 2);
+
+	rig.Link.Data.IsMoving = false;
+	CHECK(rig.Frame().Suspend == ESuspend_None);
+	CHECK(rig.Game.Toggles == 2 && !rig.Handler.IsActive());
+}
+
+TEST(Core, CursorIsResetOncePerReappearance)
+{
+	Core::Config config{};
+	config.ResetToCenter = true;
+
+	FakeRig rig(config);
+	rig.Link.Data.IsMoving       = true;
+	rig.Link.Data.IsCameraMoving = true;
+	rig.Link.CameraMoving        = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Frame();
+	CHECK(rig.Cursor.Hidden && rig.Cursor.Moves == 0);
+
+	/* Seen by WndProc first, the next frame sees the same reappearance. */
+	rig.Cursor.Hidden = false;
+	rig.Handler.Process(MakeMessage(Input::EMessage_SetCursor, 0));
+	CHECK(rig.Cursor.Moves == 1);
+	CHECK(rig.Cursor.X == 960 && rig.Cursor.Y == 540);
+	rig.Frame();
+	rig.Handler.Process(MakeMessage(Input::EMessage_SetCursor, 0));
+	CHECK(rig.Cursor.Moves == 1);
+
+	/* Seen by PreRender first, e.g. no message arrived in between. */
+	rig.Cursor.Hidden = true;
+	rig.Frame();
+	rig.Cursor.Hidden = false;
+	rig.Frame();
+	CHECK(rig.Cursor.Moves == 2);
+	rig.Handler.Process(MakeMessage(Input::EMessage_MouseMove, 0));
+	rig.Frame();
+	CHECK(rig.Cursor.Moves == 2);
+}
+
+TEST(Core, CursorJumpWindowIsTraced)
+{
+	Core::Config config{};
+	config.ResetToCenter = true;
+
+	FakeRig rig(config);
+	rig.Link.Data.IsMoving       = true;
+	rig.Link.Data.IsCameraMoving = true;
+	rig.Link.CameraMoving        = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Handler.StartRecording();
+	rig.Frame();
+
+	/* Reappears 4 ms after a frame, WndProc resets it on the next message. */
+	rig.Clock.Advance(4);
+	rig.Cursor.Hidden = false;
+	rig.Handler.Process(MakeMessage(Input::EMessage_SetCursor, 0));
+	rig.Frame();
+
+	/* Reappears without a message before the next frame, PreRender resets it. */
+	rig.Cursor.Hidden = true;
+	rig.Frame();
+	rig.Cursor.Hidden = false;
+	rig.Frame();
+
+	std::string                    replayed;
+	std::vector<Trace::CursorJump> jumps;
+	CHECK(Trace::Replay(rig.Handler.StopRecording(), replayed, nullptr, &jumps));
+	CHECK(jumps.size() == 2);
+	if (jumps.size() == 2)
+	{
+		CHECK(jumps[0].From == Trace::EResetFrom_Message && jumps[0].Milliseconds == 4.0 && jumps[0].Frames == 0);
+		CHECK(jumps[1].From == Trace::EResetFrom_Frame && jumps[1].Milliseconds == 16.0 && jumps[1].Frames == 0);
+	}
+}
+
+TEST(Core, ClientRectFollowsTheWindow)
+{
+	FakeRig rig;
+	CHECK(rig.Window.Queries == 1);
+
+	rig.Handler.Process(MakeMessage(Input::EMessage_Move, 0, 0, (int64_t)((uint32_t)(uint16_t)-50 | (200u << 16))));
+	rig.Handler.Process(MakeMessage(Input::EMessage_Size, 0, 0, (int64_t)(800 | (600 << 16))));
+
+	Geometry::ClientRect rect = rig.Handler.GetClientRect();
+	CHECK(rect.Left == -50 && rect.Top == 200 && rect.Width == 800 && rect.Height == 600);
+	CHECK(rig.Window.Queries == 1);
+
+	rig.Window.Rect = { 10, 20, 1280, 720 };
+	rig.Handler.InvalidateClientRect();
+	rig.Handler.Process(MakeMessage(Input::EMessage_KeyUp, 'W'));
+
+	rect = rig.Handler.GetClientRect();
+	CHECK(rect.Left == 10 && rect.Width == 1280 && rig.Window.Queries == 2);
+}
+
+TEST(Core, StopUndoesTheAddonsActionCam)
+{
+	FakeRig rig;
+	rig.Link.Data.IsMoving = true;
+	rig.Frame();
+	rig.ApplyToggles();
+	rig.Frame();
+
+	rig.Handler.Stop();
+	CHECK(rig.Game.Toggles == 2 && rig.Game.ImmediateToggles == 1 && !rig.Game.ActionCam);
+
+	State state{};
+	CHECK(Read(&rig.Shared, &state));
+	CHECK(state.Suspend == ESuspend_Unloaded && !state.IsActionCam);
+}
@@ -0,0 +1,291 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Fakes.h
+/// Description  :  Stand-ins for the game the tests drive the platform independent parts against.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef FAKES_H
+#define FAKES_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Core.h"
+#include "GameBindList.h"
+#include "Input.h"
+
+/* Nexus is not available here, the binds are numbered in the order the selector offers them. */
+enum EGameBinds
+{
+#define GAME_BINDS_ENUM(aMenu, aName, aLabel) EGameBinds_##aName,
+	GAME_BINDS(GAME_BINDS_ENUM)
+#undef GAME_BINDS_ENUM
+};
+
+#include "GameBinds.h"
+
+///----------------------------------------------------------------------------------------------------
+/// FakeOutput:
+/// 	Records what the router or the handler sent to the game and tracks which binds the game holds
+/// 	down. Not thread safe.
+///----------------------------------------------------------------------------------------------------
+struct FakeOutput : Core::GameProvider
+{
+	struct ButtonUpCall
+	{
+		uint32_t Msg;
+		uint64_t WParam;
+		int64_t  LParam;
+	};
+
+	void Press(Input::Bind aBind) override
+	{
+		Presses.push_back(aBind);
+		Down[aBind & 1023]++;
+	}
+
+	void Release(Input::Bind aBind) override
+	{
+		Releases.push_back(aBind);
+		Down[aBind & 1023]--;
+	}
+
+	void ButtonUp(uint32_t aMsg, uint64_t aWParam, int64_t aLParam) override
+	{
+		ButtonUps.push_back(ButtonUpCall{ aMsg, aWParam, aLParam });
+	}
+
+	void ToggleActionCam(bool aImmediate) override
+	{
+		Toggles++;
+		ImmediateToggles += aImmediate;
+		ActionCam = !ActionCam;
+	}
+
+	/* Binds the game considers held, presses minus releases. */
+	int Held() const
+	{
+		int held = 0;
+		for (int down : Down)
+		{
+			held += down;
+		}
+		return held;
+	}
+
+	void Clear()
+	{
+		Presses.clear();
+		Releases.clear();
+		ButtonUps.clear();
+		Toggles          = 0;
+		ImmediateToggles = 0;
+	}
+
+	std::vector<Input::Bind>  Presses;
+	std::vector<Input::Bind>  Releases;
+	std::vector<ButtonUpCall> ButtonUps;
+	int                       Down[1024] = {};
+	int                       Toggles          = 0;
+	int                       ImmediateToggles = 0;
+	/* Whether the toggles turned the game's action cam on, starting from off. */
+	bool                      ActionCam        = false;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeCursor:
+/// 	A cursor the test hides and moves, counting the moves the handler makes.
+///----------------------------------------------------------------------------------------------------
+struct FakeCursor : Core::CursorProvider
+{
+	bool IsHidden() override
+	{
+		return Hidden.load(std::memory_order_relaxed);
+	}
+
+	void GetPosition(int32_t& aX, int32_t& aY) override
+	{
+		aX = X.load(std::memory_order_relaxed);
+		aY = Y.load(std::memory_order_relaxed);
+	}
+
+	void SetPosition(int32_t aX, int32_t aY) override
+	{
+		X.store(aX, std::memory_order_relaxed);
+		Y.store(aY, std::memory_order_relaxed);
+		Moves.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::atomic<bool>    Hidden = false;
+	std::atomic<int32_t> X      = 0;
+	std::atomic<int32_t> Y      = 0;
+	std::atomic<int>     Moves  = 0;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeWindow:
+/// 	A window whose client area is whatever the test sets, counting the queries.
+///----------------------------------------------------------------------------------------------------
+struct FakeWindow : Core::WindowProvider
+{
+	Geometry::ClientRect QueryClientRect() override
+	{
+		Queries++;
+		return Rect;
+	}
+
+	Geometry::ClientRect Rect    = { 0, 0, 1920, 1080 };
+	int                  Queries = 0;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeLink:
+/// 	Link data the test sets before each frame. OnRead, if set, runs in the middle of reading it,
+/// 	e.g. to deliver a message while the frame is being evaluated.
+///----------------------------------------------------------------------------------------------------
+struct FakeLink : Core::LinkProvider
+{
+	FakeLink()
+	{
+		Data.IsGameplay = true;
+	}
+
+	void Read(Core::LinkData& aData) override
+	{
+		if (OnRead)
+		{
+			OnRead();
+		}
+		aData = Data;
+	}
+
+	bool IsCameraMoving() override
+	{
+		return CameraMoving.load(std::memory_order_relaxed);
+	}
+
+	Core::LinkData        Data         = {};
+	std::atomic<bool>     CameraMoving = false;
+	std::function<void()> OnRead;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeClock:
+/// 	Ticks only when the test advances it, at a millisecond per tick.
+///----------------------------------------------------------------------------------------------------
+struct FakeClock : Core::ClockProvider
+{
+	int64_t Now() override
+	{
+		return Ticks.load(std::memory_order_relaxed);
+	}
+
+	int64_t TicksPerSecond() override
+	{
+		return 1000;
+	}
+
+	void Advance(int64_t aTicks)
+	{
+		Ticks.fetch_add(aTicks, std::memory_order_relaxed);
+	}
+
+	std::atomic<int64_t> Ticks = 1;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeRig:
+/// 	A handler wired to a fake of each provider and to its own shared state and inhibit channel.
+///----------------------------------------------------------------------------------------------------
+struct FakeRig
+{
+	FakeRig(const Core::Config& aConfig = Core::Config{})
+	{
+		Shared.Version.store(MLH_STATE_VERSION, std::memory_order_relaxed);
+		Handler.Start(&Shared, &Inhibit);
+		Handler.Apply(aConfig);
+	}
+
+	/* Runs a frame a 60th of a second after the last one and returns what it published. */
+	MouseLookHandler::State Frame(bool aWantsMouse = false, bool aWantsKeyboard = false)
+	{
+		Clock.Advance(16);
+		Handler.Frame(aWantsMouse, aWantsKeyboard);
+
+		MouseLookHandler::State state{};
+		MouseLookHandler::Read(&Shared, &state);
+		return state;
+	}
+
+	/* The game applies the toggles it was sent, the cursor hides in action cam. */
+	void ApplyToggles()
+	{
+		Cursor.Hidden.store(Game.ActionCam, std::memory_order_relaxed);
+	}
+
+	FakeOutput                       Game;
+	FakeCursor                       Cursor;
+	FakeWindow                       Window;
+	FakeLink                         Link;
+	FakeClock                        Clock;
+	MouseLookHandler::SharedState    Shared  = {};
+	MouseLookHandler::InhibitChannel Inhibit = {};
+	Core::Handler                    Handler{ Game, Cursor, Window, Link, Clock };
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FakeOptionsUi:
+/// 	Renders GameBinds::Selector with every menu open, counting the elements.
+///----------------------------------------------------------------------------------------------------
+struct FakeOptionsUi
+{
+	bool BeginCombo(const char*, const char* aPreview)
+	{
+		Preview = aPreview;
+		return true;
+	}
+
+	void EndCombo()
+	{
+	}
+
+	bool BeginMenu(const char*)
+	{
+		Menus++;
+		return true;
+	}
+
+	void EndMenu()
+	{
+	}
+
+	void Selectable(Input::Bind*, const char*, EGameBinds)
+	{
+		Selectables++;
+	}
+
+	const char* Preview     = nullptr;
+	int         Menus       = 0;
+	int         Selectables = 0;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// MakeMessage:
+/// 	Returns a message on a hidden cursor, as in action cam.
+///----------------------------------------------------------------------------------------------------
+inline Input::Message MakeMessage(uint32_t aMsg, uint64_t aWParam, int64_t aNow = 0, int64_t aLParam = 0)
+{
+	Input::Message message{};
+	message.Msg          = aMsg;
+	message.WParam       = aWParam;
+	message.LParam       = aLParam;
+	message.Now          = aNow;
+	message.CursorHidden = true;
+	return message;
+}
+
+#endif
@@ -0,0 +1,81 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  GeometryTests.cpp
+/// Description  :  Client area and cursor position packing tests.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Geometry.h"
+#include "Test.h"
+
+struct Point
+{
+	int32_t x;
+	int32_t y;
+};
+
+static bool Equals(const Geometry::ClientRect& aLeft, const Geometry::ClientRect& aRight)
+{
+	return aLeft.Left == aRight.Left && aLeft.Top == aRight.Top && aLeft.Width == aRight.Width && aLeft.Height == aRight.Height;
+}
+
+TEST(Geometry, CentersOnTheClientArea)
+{
+	/* A windowed client offset by its title bar. */
+	const Geometry::ClientRect rect = { 108, 131, 1600, 900 };
+
+	CHECK(Geometry::CenterX(rect) == 908);
+	CHECK(Geometry::CenterY(rect) == 581);
+}
+
+TEST(Geometry, CentersOnMonitorsLeftOfThePrimary)
+{
+	const Geometry::ClientRect rect = { -2560, -200, 2560, 1440 };
+
+	CHECK(Geometry::CenterX(rect) == -1280);
+	CHECK(Geometry::CenterY(rect) == 520);
+}
+
+TEST(Geometry, PackRoundTrips)
+{
+	const Geometry::ClientRect rects[] = {
+		{ 0, 0, 1920, 1080 },
+		{ 108, 131, 1600, 900 },
+		{ -2560, -200, 2560, 1440 },
+		{ -32768, 32767, 65535, 65535 },
+		{ 0, 0, 0, 0 }
+	};
+
+	for (const Geometry::ClientRect& rect : rects)
+	{
+		CHECK(Equals(Geometry::Unpack(Geometry::Pack(rect)), rect));
+	}
+}
+
+TEST(Geometry, PackPointRoundTrips)
+{
+	const Point points[] = { { 0, 0 }, { 959, 539 }, { -1, -1 }, { -2560, 1440 }, { INT32_MIN, INT32_MAX } };
+
+	for (const Point& point : points)
+	{
+		Point unpacked = Geometry::UnpackPoint<Point>(Geometry::PackPoint(point.x, point.y));
+		CHECK(unpacked.x == point.x);
+		CHECK(unpacked.y == point.y);
+	}
+}
+
+TEST(Geometry, ClampsIntoTheClientArea)
+{
+	const Geometry::ClientRect rect = { -2560, 100, 2560, 1440 };
+
+	CHECK(Geometry::ClampX(rect, 10) == -2550);
+	CHECK(Geometry::ClampY(rect, 10) == 110);
+
+	/* The window shrank since the position was saved. */
+	CHECK(Geometry::ClampX(rect, 4000) == -1);
+	CHECK(Geometry::ClampY(rect, 2000) == 1539);
+
+	CHECK(Geometry::ClampX(rect, -5) == -2560);
+	CHECK(Geometry::ClampY(rect, -5) == 100);
+}
@@ -0,0 +1,644 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  InputTests.cpp
+/// Description  :  Input::Router redirect, chord, remap and drag tests.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <thread>
+
+#include "Input.h"
+#include "Fakes.h"
+#include "Test.h"
+
+using namespace Input;
+
+static constexpr int64_t TPS = 1000; /* Ticks are milliseconds. */
+
+enum : Bind
+{
+	BIND_DEFAULT_LMB = 10,
+	BIND_DEFAULT_RMB = 11,
+	BIND_COMBAT_LMB  = 20,
+	BIND_SHIFT_LMB   = 30,
+	BIND_CHORD       = 40,
+	BIND_REMAP       = 50
+};
+
+static Settings MakeSettings()
+{
+	Settings settings{};
+	settings.Redirect[ERedirectButton_LMB] = true;
+	settings.Redirect[ERedirectButton_RMB] = true;
+	settings.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = BIND_DEFAULT_LMB;
+	settings.RedirectTarget[ERedirectContext_Default][ERedirectButton_RMB] = BIND_DEFAULT_RMB;
+	settings.RedirectOverride[ERedirectContext_Combat][ERedirectButton_LMB] = true;
+	settings.RedirectTarget[ERedirectContext_Combat][ERedirectButton_LMB]   = BIND_COMBAT_LMB;
+	settings.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Shift] = true;
+	settings.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Shift]   = BIND_SHIFT_LMB;
+	settings.ChordTarget   = BIND_CHORD;
+	settings.ChordWindowMs = 50;
+	settings.RemapKeys     = true;
+	settings.KeyRemap['Q']       = true;
+	settings.KeyRemapTarget['Q'] = BIND_REMAP;
+	return settings;
+}
+
+static void Enter(Router& aRouter, const Settings& aSettings)
+{
+	aRouter.Apply(aSettings, TPS);
+	aRouter.SetContext(ERedirectContext_Default);
+	aRouter.SetActionCam(true);
+}
+
+TEST(Input, RedirectsClicksInActionCam)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	CHECK(output.Presses.size() == 1 && output.Presses[0] == BIND_DEFAULT_LMB);
+	CHECK(router.Held() == 1);
+
+	/* Releases are passed on to the game as well. */
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonUp, 0), output));
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_DEFAULT_LMB);
+	CHECK(router.Held() == 0);
+}
+
+TEST(Input, SelectsContextAndModifiers)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	router.SetContext(ERedirectContext_Combat);
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output);
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+
+	/* Not overridden in combat, the default target is used. */
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton), output);
+	router.Process(MakeMessage(EMessage_RButtonUp, 0), output);
+
+	/* The modifier override wins over the context. */
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_Shift), output);
+	router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_Shift), output);
+
+	/* Alt comes from the key state, not the wParam. Not overridden, falls back to the context. */
+	Message alt = MakeMessage(EMessage_LButtonDown, EMouseKey_LButton);
+	alt.Alt = true;
+	router.Process(alt, output);
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+
+	CHECK(output.Presses.size() == 4);
+	CHECK(output.Presses[0] == BIND_COMBAT_LMB);
+	CHECK(output.Presses[1] == BIND_DEFAULT_RMB);
+	CHECK(output.Presses[2] == BIND_SHIFT_LMB);
+	CHECK(output.Presses[3] == BIND_COMBAT_LMB);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, ReleasesWhatWasPressed)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output);
+
+	/* Combat starts, action cam ends and the settings change while the button is held. */
+	router.SetContext(ERedirectContext_Combat);
+	router.SetActionCam(false);
+	Settings settings = MakeSettings();
+	settings.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = 99;
+	router.Apply(settings, TPS);
+
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_DEFAULT_LMB);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, DoubleClickReleasesTheOldTarget)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output);
+	router.SetContext(ERedirectContext_Combat);
+	router.Process(MakeMessage(EMessage_LButtonDblClk, EMouseKey_LButton), output);
+
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_DEFAULT_LMB);
+	CHECK(router.Held() == 1);
+
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, PassesClicksOnWhenNotInCharge)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	router.SetActionCam(false);
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+	router.SetActionCam(true);
+
+	router.Suspend();
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+	router.SetContext(ERedirectContext_Default);
+
+	router.SetWantsMouse(true);
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+	router.SetWantsMouse(false);
+
+	Message inhibited = MakeMessage(EMessage_LButtonDown, EMouseKey_LButton);
+	inhibited.Inhibited = true;
+	CHECK(!router.Process(inhibited, output));
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+
+	Settings settings = MakeSettings();
+	settings.Redirect[ERedirectButton_LMB] = false;
+	router.Apply(settings, TPS);
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+
+	CHECK(output.Presses.empty());
+}
+
+TEST(Input, TracksDrags)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	/* Going down on a visible cursor is a camera drag, the game hides the cursor for it. */
+	Message down = MakeMessage(EMessage_RButtonDown, EMouseKey_RButton);
+	down.CursorHidden = false;
+	CHECK(!router.Process(down, output));
+	CHECK(router.IsDragging());
+
+	/* Clicks during the drag go to the game. */
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_RButton), output));
+	CHECK(router.IsDragging());
+
+	router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_RButton), output);
+	CHECK(router.IsDragging());
+
+	router.Process(MakeMessage(EMessage_RButtonUp, 0), output);
+	CHECK(!router.IsDragging());
+	CHECK(output.Presses.empty());
+}
+
+TEST(Input, DropsDragsWhoseUpWasMissed)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	Message down = MakeMessage(EMessage_RButtonDown, EMouseKey_RButton);
+	down.CursorHidden = false;
+	router.Process(down, output);
+
+	/* The up was lost with the focus, the next down no longer has the button in its wParam. */
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	CHECK(!router.IsDragging());
+	CHECK(output.Presses.size() == 1 && output.Presses[0] == BIND_DEFAULT_LMB);
+}
+
+TEST(Input, ChordsBothButtons)
+{
+	Router     router;
+	FakeOutput output;
+	Settings   settings = MakeSettings();
+	settings.Redirect[ERedirectButton_LMB] = false;
+	settings.Chord = true;
+	Enter(router, settings);
+
+	/* The first button goes to the game. */
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 100), output));
+
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 130), output));
+	CHECK(output.ButtonUps.size() == 1 && output.ButtonUps[0].Msg == EMessage_LButtonUp);
+	CHECK(output.ButtonUps.size() == 1 && output.ButtonUps[0].WParam == EMouseKey_RButton);
+	CHECK(output.Presses.size() == 1 && output.Presses[0] == BIND_CHORD);
+
+	/* Either button going up ends the chord. */
+	router.Process(MakeMessage(EMessage_RButtonUp, EMouseKey_LButton, 200), output);
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_CHORD);
+
+	router.Process(MakeMessage(EMessage_LButtonUp, 0, 210), output);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, ChordCancelsARedirect)
+{
+	Router     router;
+	FakeOutput output;
+	Settings   settings = MakeSettings();
+	settings.Chord = true;
+	Enter(router, settings);
+
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 100), output));
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 120), output));
+
+	/* The redirect is released instead of sending the game an up for a down it never saw. */
+	CHECK(output.ButtonUps.empty());
+	CHECK(output.Presses.size() == 2 && output.Presses[0] == BIND_DEFAULT_LMB && output.Presses[1] == BIND_CHORD);
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_DEFAULT_LMB);
+
+	router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_RButton, 200), output);
+	router.Process(MakeMessage(EMessage_RButtonUp, 0, 210), output);
+	CHECK(output.Held() == 0);
+	CHECK(router.Held() == 0);
+}
+
+TEST(Input, ChordOutsideTheWindowIsTwoClicks)
+{
+	Router     router;
+	FakeOutput output;
+	Settings   settings = MakeSettings();
+	settings.Chord = true;
+	Enter(router, settings);
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 100), output);
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 151), output);
+
+	CHECK(output.Presses.size() == 2 && output.Presses[0] == BIND_DEFAULT_LMB && output.Presses[1] == BIND_DEFAULT_RMB);
+	CHECK(output.ButtonUps.empty());
+}
+
+TEST(Input, RemapsKeysInActionCam)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	CHECK(router.Process(MakeMessage(EMessage_KeyDown, 'Q'), output));
+	CHECK(output.Presses.size() == 1 && output.Presses[0] == BIND_REMAP);
+
+	/* Autorepeat is swallowed, the bind is already held. */
+	CHECK(router.Process(MakeMessage(EMessage_KeyDown, 'Q', 0, 1 << 30), output));
+	CHECK(output.Presses.size() == 1);
+
+	CHECK(!router.Process(MakeMessage(EMessage_KeyUp, 'Q'), output));
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_REMAP);
+
+	/* Other keys and keys outside action cam go to the game. */
+	CHECK(!router.Process(MakeMessage(EMessage_KeyDown, 'E'), output));
+	router.SetActionCam(false);
+	CHECK(!router.Process(MakeMessage(EMessage_KeyDown, 'Q'), output));
+	CHECK(!router.Process(MakeMessage(EMessage_KeyDown, 'Q', 0, 1 << 30), output));
+	router.Process(MakeMessage(EMessage_KeyUp, 'Q'), output);
+
+	router.SetActionCam(true);
+	router.Suspend();
+	CHECK(!router.Process(MakeMessage(EMessage_KeyDown, 'Q'), output));
+	CHECK(output.Presses.size() == 1);
+}
+
+TEST(Input, RemapsNothingBeforeSettingsAreApplied)
+{
+	Router     router;
+	FakeOutput output;
+	router.SetActionCam(true);
+
+	for (uint32_t vk = 0; vk < 256; vk++)
+	{
+		CHECK(!router.Process(MakeMessage(EMessage_KeyDown, vk), output));
+	}
+
+	CHECK(output.Presses.empty());
+}
+
+TEST(Input, ReleaseAllReleasesEverything)
+{
+	Router     router;
+	FakeOutput output;
+	Settings   settings = MakeSettings();
+	settings.Chord = true;
+	Enter(router, settings);
+
+	router.Process(MakeMessage(EMessage_KeyDown, 'Q'), output);
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 100), output);
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 110), output);
+	CHECK(router.Held() == 2);
+
+	router.ReleaseAll(output);
+	CHECK(router.Held() == 0);
+	CHECK(output.Held() == 0);
+
+	/* The ups arriving later have nothing left to release. */
+	size_t releases = output.Releases.size();
+	router.Process(MakeMessage(EMessage_KeyUp, 'Q'), output);
+	router.Process(MakeMessage(EMessage_LButtonUp, 0), output);
+	CHECK(output.Releases.size() == releases);
+}
+
+TEST(Input, UiKeys)
+{
+	Router   router;
+	Settings settings = MakeSettings();
+	settings.UiKey['I'] = true;
+	router.Apply(settings, TPS);
+	CHECK(!router.IsUiKey('I'));
+
+	settings.ExitOnUiKeys = true;
+	router.Apply(settings, TPS);
+	CHECK(router.IsUiKey('I'));
+	CHECK(!router.IsUiKey('Q'));
+}
+
+TEST(Input, TracksPanelsByTheirKeys)
+{
+	Router   router;
+	Settings settings = MakeSettings();
+	settings.ExitOnUiKeys = true;
+	settings.UiKey['I']   = true;
+	settings.UiKey['H']   = true;
+	router.Apply(settings, TPS);
+
+	CHECK(router.TogglePanel('I'));
+	CHECK(router.TogglePanel('H'));
+	CHECK(!router.TogglePanel('I'));
+	CHECK(router.IsPanelOpen());
+
+	/* The key of the last open panel closes it. */
+	CHECK(!router.TogglePanel('H'));
+	CHECK(!router.IsPanelOpen());
+
+	CHECK(router.TogglePanel('I'));
+	router.ClosePanels();
+	CHECK(!router.IsPanelOpen());
+	CHECK(router.TogglePanel('I'));
+}
+
+static Router& ChordRouter(Router& aRouter)
+{
+	Settings settings = MakeSettings();
+	settings.Redirect[ERedirectButton_LMB] = false;
+	settings.Redirect[ERedirectButton_RMB] = false;
+	settings.Chord = true;
+	Enter(aRouter, settings);
+	return aRouter;
+}
+
+TEST(Input, ChordWindowIsInclusive)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1050), output));
+	router.Process(MakeMessage(EMessage_RButtonUp, EMouseKey_LButton, 1060), output);
+	router.Process(MakeMessage(EMessage_LButtonUp, 0, 1070), output);
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 2000), output);
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 2051), output));
+
+	CHECK(output.Presses.size() == 1);
+}
+
+TEST(Input, ChordNeedsTheOtherButtonHeld)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	/* A quick click followed by the other button is no chord, the first one is already up. */
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	router.Process(MakeMessage(EMessage_LButtonUp, 0, 1005), output);
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton, 1010), output));
+
+	CHECK(output.Presses.empty());
+	CHECK(output.ButtonUps.empty());
+}
+
+TEST(Input, ChordIsNotRepeatedWhileHoldingOneButton)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1010), output));
+	router.Process(MakeMessage(EMessage_RButtonUp, EMouseKey_LButton, 1020), output);
+
+	/* Still within the window of the left down, which the first chord used up. */
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1030), output));
+	CHECK(output.Presses.size() == 1);
+	CHECK(output.ButtonUps.size() == 1);
+}
+
+TEST(Input, ChordSurvivesOutOfOrderTicks)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	/* Performance counters read on different cores may go back a little. */
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 995), output));
+	router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_RButton, 1010), output);
+	router.Process(MakeMessage(EMessage_RButtonUp, 0, 1020), output);
+
+	/* Weeks of uptime. */
+	const int64_t late = INT64_MAX - 100;
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton, late), output);
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_RButton, late + 50), output));
+	router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_RButton, late + 60), output);
+	router.Process(MakeMessage(EMessage_RButtonUp, 0, late + 70), output);
+
+	CHECK(output.Presses.size() == 2);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, ChordMashing)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	/* Mashing both buttons, every pair within the window is one chord and every chord is released. */
+	int64_t now    = 1000;
+	size_t  chords = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		ERedirectButton first = i & 1 ? ERedirectButton_LMB : ERedirectButton_RMB;
+		uint32_t        down  = first == ERedirectButton_LMB ? EMessage_LButtonDown : EMessage_RButtonDown;
+		uint32_t        other = first == ERedirectButton_LMB ? EMessage_RButtonDown : EMessage_LButtonDown;
+		int64_t         gap   = (i * 7) % 80;
+
+		router.Process(MakeMessage(down, 1u << first, now), output);
+		chords += router.Process(MakeMessage(other, EMouseKey_LButton | EMouseKey_RButton, now + gap), output) ? 1 : 0;
+		router.Process(MakeMessage(EMessage_LButtonUp, EMouseKey_RButton, now + gap + 5), output);
+		router.Process(MakeMessage(EMessage_RButtonUp, 0, now + gap + 6), output);
+
+		now += 100;
+	}
+
+	CHECK(chords == output.ButtonUps.size());
+	CHECK(chords > 0 && chords < 1000);
+	CHECK(output.Held() == 0);
+	CHECK(router.Held() == 0);
+}
+
+TEST(Input, ChordLeavesAddonWindowsAlone)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+	router.SetWantsMouse(true);
+
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1010), output));
+	CHECK(output.Presses.empty());
+	CHECK(output.ButtonUps.empty());
+}
+
+TEST(Input, ChordCancelKeepsTheCursorPosition)
+{
+	Router     router;
+	FakeOutput output;
+	ChordRouter(router);
+
+	const int64_t position = (300 << 16) | 400;
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton, 1000, position), output);
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1010, position), output);
+
+	CHECK(output.ButtonUps.size() == 1);
+	CHECK(output.ButtonUps.size() == 1 && output.ButtonUps[0].Msg == EMessage_RButtonUp);
+	CHECK(output.ButtonUps.size() == 1 && output.ButtonUps[0].LParam == position);
+}
+
+TEST(Input, MouseMovesEndMissedDrags)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	Message down = MakeMessage(EMessage_RButtonDown, EMouseKey_RButton);
+	down.CursorHidden = false;
+	router.Process(down, output);
+
+	CHECK(!router.Process(MakeMessage(EMessage_MouseMove, EMouseKey_RButton | EMouseKey_Shift), output));
+	CHECK(router.IsDragging());
+
+	/* Released outside the window, the up never arrived. */
+	CHECK(!router.Process(MakeMessage(EMessage_MouseMove, EMouseKey_Shift), output));
+	CHECK(!router.IsDragging());
+	CHECK(output.Presses.empty());
+}
+
+TEST(Input, MouseMovesReleaseMissedRedirects)
+{
+	Router     router;
+	FakeOutput output;
+	Settings   settings = MakeSettings();
+	settings.Chord = true;
+	Enter(router, settings);
+
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+	CHECK(router.Process(MakeMessage(EMessage_MouseMove, EMouseKey_LButton), output) == false);
+	CHECK(output.Held() == 1);
+
+	/* E.g. focus was lost while held, the up never arrived. */
+	router.Process(MakeMessage(EMessage_MouseMove, 0), output);
+	CHECK(output.Held() == 0);
+	CHECK(router.Held() == 0);
+
+	/* Chords end once either button is gone. */
+	router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton, 1000), output);
+	router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_LButton | EMouseKey_RButton, 1010), output);
+	CHECK(output.Down[BIND_CHORD] == 1);
+
+	router.Process(MakeMessage(EMessage_MouseMove, EMouseKey_RButton, 1020), output);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, AddonWindowOpeningDuringAClickStillReleases)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	CHECK(router.Process(MakeMessage(EMessage_LButtonDown, EMouseKey_LButton), output));
+
+	/* The render thread saw a window under the cursor between the down and the up. */
+	router.SetWantsMouse(true);
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonDblClk, EMouseKey_LButton), output));
+	CHECK(output.Held() == 1);
+
+	CHECK(!router.Process(MakeMessage(EMessage_LButtonUp, 0), output));
+	CHECK(output.Releases.size() == 1 && output.Releases[0] == BIND_DEFAULT_LMB);
+	CHECK(output.Held() == 0);
+	CHECK(router.Held() == 0);
+}
+
+TEST(Input, AddonWindowClosingDuringAClickReleasesNothing)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	router.SetWantsMouse(true);
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton), output));
+
+	/* The window closed, the up belongs to the click the window got. */
+	router.SetWantsMouse(false);
+	CHECK(!router.Process(MakeMessage(EMessage_RButtonUp, 0), output));
+	CHECK(output.Presses.empty());
+	CHECK(output.Releases.empty());
+
+	/* The next click is redirected again. */
+	CHECK(router.Process(MakeMessage(EMessage_RButtonDown, EMouseKey_RButton), output));
+	router.Process(MakeMessage(EMessage_RButtonUp, 0), output);
+	CHECK(output.Held() == 0);
+}
+
+TEST(Input, AddonWindowsFlickeringDuringClicks)
+{
+	Router     router;
+	FakeOutput output;
+	Enter(router, MakeSettings());
+
+	/* The render thread publishes the flag every frame while the message thread clicks. */
+	std::atomic<bool> done{ false };
+	std::thread render([&]()
+	{
+		for (uint32_t frame = 0; !done.load(std::memory_order_relaxed); frame++)
+		{
+			router.SetWantsMouse((frame / 3) & 1);
+			std::this_thread::yield();
+		}
+	});
+
+	size_t redirected = 0;
+	bool   stuck      = false;
+	for (int64_t now = 0; now < 20000; now += 10)
+	{
+		uint64_t buttons = (now / 10) & 1 ? EMouseKey_RButton : EMouseKey_LButton;
+		uint32_t down    = buttons == EMouseKey_LButton ? EMessage_LButtonDown : EMessage_RButtonDown;
+		uint32_t up      = buttons == EMouseKey_LButton ? EMessage_LButtonUp   : EMessage_RButtonUp;
+
+		redirected += router.Process(MakeMessage(down, buttons, now), output) ? 1 : 0;
+		router.Process(MakeMessage(up, 0, now + 5), output);
+
+		stuck |= output.Held() != 0 || router.Held() != 0;
+	}
+
+	done.store(true, std::memory_order_relaxed);
+	render.join();
+
+	CHECK(!stuck);
+	CHECK(output.Presses.size() == redirected);
+	CHECK(output.Releases.size() == redirected);
+}
@@ -0,0 +1,39 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Main.cpp
+/// Description  :  Runs the tests of one suite, or all of them.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "Test.h"
+
+int main(int argc, char** argv)
+{
+	const char* suite = argc > 1 ? argv[1] : nullptr;
+	int         ran   = 0;
+
+	for (const Test::Case& test : Test::Cases())
+	{
+		if (suite && strcmp(suite, test.Suite) != 0)
+		{
+			continue;
+		}
+
+		int failures = Test::Failures();
+		test.Func();
+		ran++;
+
+		printf("%s %s.%s\n", Test::Failures() == failures ? "pass" : "FAIL", test.Suite, test.Name);
+	}
+
+	if (ran == 0)
+	{
+		fprintf(stderr, "no tests in suite %s\n", suite ? suite : "(all)");
+		return 1;
+	}
+
+	return Test::Failures() == 0 ? 0 : 1;
+}
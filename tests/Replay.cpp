@@ -0,0 +1,85 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Replay.cpp
+/// Description  :  Replays a recorded trace.mlht outside the game.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Trace.h"
+
+///----------------------------------------------------------------------------------------------------
+/// NextAction:
+/// 	Returns the next line of aOut without its time, times of recorded and replayed outputs differ
+/// 	by the few ticks between a message and the bind it caused. Empty at the end.
+///----------------------------------------------------------------------------------------------------
+static std::string NextAction(std::istringstream& aOut, std::string& aLine)
+{
+	if (!std::getline(aOut, aLine))
+	{
+		aLine.clear();
+		return std::string();
+	}
+
+	size_t space = aLine.find(' ');
+	return space == std::string::npos ? aLine : aLine.substr(space + 1);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s trace.mlht\n"
+		                "Prints the replayed toggles, presses, releases and button ups and compares them to the recorded ones.\n"
+		                "Then prints how long the cursor showed at its old position before each reset.\n", argv[0]);
+		return 1;
+	}
+
+	std::ifstream file(argv[1], std::ios::binary);
+	std::vector<uint8_t> trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	std::string                    replayed;
+	std::string                    recorded;
+	std::vector<Trace::CursorJump> jumps;
+	if (!Trace::Replay(trace, replayed, &recorded, &jumps))
+	{
+		fprintf(stderr, "%s is missing or malformed.\n", argv[1]);
+		return 1;
+	}
+
+	fputs(replayed.c_str(), stdout);
+
+	for (const Trace::CursorJump& jump : jumps)
+	{
+		printf("cursor reset from %s after %.3f ms, %u frames\n", jump.From == Trace::EResetFrom_Message ? "WndProc" : "PreRender", jump.Milliseconds, jump.Frames);
+	}
+
+	std::istringstream replayedLines(replayed);
+	std::istringstream recordedLines(recorded);
+	std::string        replayedLine;
+	std::string        recordedLine;
+
+	for (int line = 1;; line++)
+	{
+		std::string replayedAction = NextAction(replayedLines, replayedLine);
+		std::string recordedAction = NextAction(recordedLines, recordedLine);
+
+		if (replayedAction != recordedAction)
+		{
+			fprintf(stderr, "line %d differs, replayed \"%s\", recorded \"%s\"\n", line, replayedLine.c_str(), recordedLine.c_str());
+			return 2;
+		}
+
+		if (replayedAction.empty())
+		{
+			return 0;
+		}
+	}
+}
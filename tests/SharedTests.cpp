@@ -0,0 +1,180 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  SharedTests.cpp
+/// Description  :  InhibitChannel tests with several addons claiming and setting bits at once.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Shared.h"
+#include "Test.h"
+
+using namespace MouseLookHandler;
+
+static constexpr int PRODUCERS = 8;
+
+///----------------------------------------------------------------------------------------------------
+/// RunProducers:
+/// 	Starts aCount threads running aBody(index) together and waits for all of them.
+///----------------------------------------------------------------------------------------------------
+template <typename Body>
+static void RunProducers(int aCount, Body&& aBody)
+{
+	std::atomic<bool>        start{ false };
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < aCount; i++)
+	{
+		threads.emplace_back([&, i]()
+		{
+			while (!start.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+			aBody(i);
+		});
+	}
+
+	start.store(true, std::memory_order_release);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+TEST(Shared, ProducersClaimDistinctBits)
+{
+	InhibitChannel channel{};
+	std::atomic<uint64_t> claimed[PRODUCERS] = {};
+
+	RunProducers(PRODUCERS, [&](int aIndex)
+	{
+		for (int i = 0; i < 64 / PRODUCERS; i++)
+		{
+			int bit = ClaimInhibit(&channel);
+			if (bit >= 0)
+			{
+				claimed[aIndex].fetch_or(1ull << bit, std::memory_order_relaxed);
+			}
+		}
+	});
+
+	uint64_t all = 0;
+	bool     overlap = false;
+	for (const std::atomic<uint64_t>& bits : claimed)
+	{
+		overlap |= (all & bits.load()) != 0;
+		all     |= bits.load();
+	}
+
+	CHECK(!overlap);
+	CHECK(all == ~0ull);
+	CHECK(channel.Claimed.load() == ~0ull);
+	CHECK(ClaimInhibit(&channel) == -1);
+}
+
+TEST(Shared, ProducersDoNotClearEachOthersBits)
+{
+	InhibitChannel    channel{};
+	std::atomic<bool> lost{ false };
+
+	RunProducers(PRODUCERS, [&](int)
+	{
+		int bit = ClaimInhibit(&channel);
+
+		for (int i = 0; i < 20000; i++)
+		{
+			SetInhibit(&channel, bit, true);
+			if (!(channel.Inhibit.load(std::memory_order_acquire) & (1ull << bit)))
+			{
+				lost.store(true, std::memory_order_relaxed);
+			}
+
+			SetInhibit(&channel, bit, false);
+			if (channel.Inhibit.load(std::memory_order_acquire) & (1ull << bit))
+			{
+				lost.store(true, std::memory_order_relaxed);
+			}
+		}
+
+		ReleaseInhibit(&channel, bit);
+	});
+
+	CHECK(!lost.load());
+	CHECK(channel.Inhibit.load() == 0);
+	CHECK(channel.Claimed.load() == 0);
+}
+
+TEST(Shared, OneHeldBitKeepsActionCamInhibited)
+{
+	InhibitChannel    channel{};
+	std::atomic<bool> done{ false };
+	std::atomic<bool> released{ false };
+
+	/* An addon with an interactive window open the whole time. */
+	int holder = ClaimInhibit(&channel);
+	SetInhibit(&channel, holder, true);
+
+	std::thread reader([&]()
+	{
+		while (!done.load(std::memory_order_acquire))
+		{
+			if (channel.Inhibit.load(std::memory_order_acquire) == 0)
+			{
+				released.store(true, std::memory_order_relaxed);
+			}
+		}
+	});
+
+	RunProducers(PRODUCERS - 1, [&](int)
+	{
+		for (int i = 0; i < 20000; i++)
+		{
+			int bit = ClaimInhibit(&channel);
+			SetInhibit(&channel, bit, i & 1);
+			ReleaseInhibit(&channel, bit);
+		}
+	});
+
+	done.store(true, std::memory_order_release);
+	reader.join();
+
+	CHECK(!released.load());
+	CHECK(channel.Inhibit.load() == (1ull << holder));
+
+	ReleaseInhibit(&channel, holder);
+	CHECK(channel.Inhibit.load() == 0);
+	CHECK(channel.Claimed.load() == 0);
+}
+
+TEST(Shared, ReclaimedBitsHaveOneOwner)
+{
+	InhibitChannel   channel{};
+	std::atomic<int> owners[64] = {};
+	std::atomic<bool> shared{ false };
+
+	RunProducers(PRODUCERS, [&](int)
+	{
+		for (int i = 0; i < 20000; i++)
+		{
+			int bit = ClaimInhibit(&channel);
+			if (owners[bit].fetch_add(1, std::memory_order_relaxed) != 0)
+			{
+				shared.store(true, std::memory_order_relaxed);
+			}
+
+			SetInhibit(&channel, bit, true);
+			owners[bit].fetch_sub(1, std::memory_order_relaxed);
+			ReleaseInhibit(&channel, bit);
+		}
+	});
+
+	CHECK(!shared.load());
+	CHECK(channel.Inhibit.load() == 0);
+	CHECK(channel.Claimed.load() == 0);
+}
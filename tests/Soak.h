@@ -0,0 +1,480 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Soak.h
+/// Description  :  Multi-hour synthetic runs of the activation and input logic in compressed time.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef SOAK_H
+#define SOAK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Activation.h"
+#include "Input.h"
+#include "Profiler.h"
+
+#define SOAK_TICKS_PER_SECOND 10000000 /* Same as a typical performance counter. */
+#define SOAK_LATENCY_BUCKETS  4096     /* Nanoseconds, the last bucket collects everything slower. */
+
+
+///----------------------------------------------------------------------------------------------------
+/// Soak Namespace
+/// 	Feeds Activation::Step randomised link frames, manual overrides, UI panels and toggles the game
+/// 	applies late or makes on its own, and Input::Router a player's clicks, chords and keys, for hours
+/// 	of simulated time, as fast as possible.
+///----------------------------------------------------------------------------------------------------
+namespace Soak
+{
+	///----------------------------------------------------------------------------------------------------
+	/// Latency:
+	/// 	Wall time of one kind of call over an hour.
+	///----------------------------------------------------------------------------------------------------
+	struct Latency
+	{
+		uint32_t Buckets[SOAK_LATENCY_BUCKETS]; /* Calls per nanosecond. */
+		uint64_t Max;                           /* Nanoseconds */
+		uint64_t Calls;
+
+		void Add(uint64_t aNanoseconds)
+		{
+			Buckets[aNanoseconds < SOAK_LATENCY_BUCKETS ? aNanoseconds : SOAK_LATENCY_BUCKETS - 1]++;
+			Max = aNanoseconds > Max ? aNanoseconds : Max;
+			Calls++;
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Hour:
+	/// 	Figures of one simulated hour. Fixed size, nothing grows with the length of a run.
+	///----------------------------------------------------------------------------------------------------
+	struct Hour
+	{
+		Latency  Steps;
+		Latency  Messages;
+		uint64_t Toggles;
+		uint64_t Overrides;
+		uint64_t Drops;           /* The game left action cam without the addon noticing. */
+		uint64_t Presses;
+		uint64_t Allocations;     /* Made by Step or the router, must stay 0 so their memory cannot grow. */
+		uint64_t StuckBinds;      /* Frames a bind was held while the player held no button or key. */
+		int64_t  Held;            /* Longest stretch the addon believed it held action cam while the game had it off, ticks. */
+		bool     OverrideOverdue; /* An override outlived its timeout. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Percentile:
+	/// 	Returns the latency below which aFraction of the calls finished, in nanoseconds.
+	///----------------------------------------------------------------------------------------------------
+	inline uint64_t Percentile(const Latency& aLatency, double aFraction)
+	{
+		uint64_t rank = (uint64_t)(aLatency.Calls * aFraction);
+		uint64_t seen = 0;
+
+		for (uint64_t ns = 0; ns < SOAK_LATENCY_BUCKETS; ns++)
+		{
+			seen += aLatency.Buckets[ns];
+			if (seen > rank)
+			{
+				return ns + 1 < SOAK_LATENCY_BUCKETS ? ns : aLatency.Max;
+			}
+		}
+
+		return aLatency.Max;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Random:
+	/// 	xorshift64*, reproducible from the seed on every platform.
+	///----------------------------------------------------------------------------------------------------
+	struct Random
+	{
+		uint64_t State;
+
+		uint64_t Next()
+		{
+			State ^= State >> 12;
+			State ^= State << 25;
+			State ^= State >> 27;
+			return State * 0x2545F4914F6CDD1Dull;
+		}
+
+		/* Uniform in [aMin, aMax]. */
+		int64_t Range(int64_t aMin, int64_t aMax)
+		{
+			return aMin + (int64_t)(Next() % (uint64_t)(aMax - aMin + 1));
+		}
+
+		/* True once in aTimes on average. */
+		bool OneIn(uint64_t aTimes)
+		{
+			return Next() % aTimes == 0;
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Output:
+	/// 	Stands in for the game binds, counts how many are held down.
+	///----------------------------------------------------------------------------------------------------
+	class Output : public Input::Output
+	{
+	public:
+		void Press(Input::Bind) override
+		{
+			Held++;
+			Presses++;
+		}
+
+		void Release(Input::Bind) override
+		{
+			Held--;
+		}
+
+		void ButtonUp(uint32_t, uint64_t, int64_t) override
+		{
+		}
+
+		int64_t  Held    = 0;
+		uint64_t Presses = 0;
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Player:
+	/// 	What the simulated player holds down.
+	///----------------------------------------------------------------------------------------------------
+	struct Player
+	{
+		uint64_t Buttons;    /* EMouseKey_LButton | EMouseKey_RButton */
+		uint64_t Modifiers;  /* EMouseKey_Shift | EMouseKey_Control */
+		bool     Alt;
+		bool     KeyDown[2]; /* A remapped key and one that is not. */
+		bool     Synced;     /* A mouse move has carried Buttons since an up was missed. */
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// Run:
+	/// 	Simulates aHours hours, prints p50/p99/max step and message latency and the other figures per
+	/// 	hour to aOut. Returns false if any hour allocated, kept an override past its timeout, held on
+	/// 	to action cam it no longer had for longer than conditions last or kept a bind held the player
+	/// 	let go of, or if a bind is still held once the player let go of everything at the end.
+	///----------------------------------------------------------------------------------------------------
+	inline bool Run(int aHours, uint64_t aSeed, std::string& aOut)
+	{
+		const int64_t  tps         = SOAK_TICKS_PER_SECOND;
+		const int64_t  hourTicks   = tps * 3600;
+		const int64_t  heldLimit   = tps * 30;      /* Conditions never last longer than 15 s. */
+		const int64_t  start       = 1ll << 50;     /* Weeks of uptime, so tick arithmetic is exercised near large values. */
+		const uint32_t keys[2]     = { 'Q', 'W' };
+		const int64_t  chordWindow = tps * 50 / 1000;
+
+		Random            rng{ aSeed | 1 };
+		Activation::State state{};
+		Activation::Rules rules{ EOverrideExpiry_OnConditionChange, tps * 5, tps / 4 };
+		Hour              hour{};
+		bool              passed = true;
+		char              line[384];
+
+		Input::Settings settings{};
+		settings.Redirect[ERedirectButton_LMB] = true;
+		settings.Redirect[ERedirectButton_RMB] = true;
+		for (int ctx = 0; ctx < ERedirectContext_COUNT; ctx++)
+		{
+			settings.RedirectOverride[ctx][ERedirectButton_LMB] = ctx != ERedirectContext_Default;
+			settings.RedirectTarget[ctx][ERedirectButton_LMB]   = 10 + ctx;
+			settings.RedirectTarget[ctx][ERedirectButton_RMB]   = 20 + ctx;
+		}
+		settings.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Shift] = true;
+		settings.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Shift]   = 30;
+		settings.RedirectModifierOverride[ERedirectButton_RMB][ERedirectModifier_Ctrl | ERedirectModifier_Alt] = true;
+		settings.RedirectModifierTarget[ERedirectButton_RMB][ERedirectModifier_Ctrl | ERedirectModifier_Alt]   = 31;
+		settings.Chord                 = true;
+		settings.ChordTarget           = 40;
+		settings.ChordWindowMs         = 50;
+		settings.RemapKeys             = true;
+		settings.KeyRemap[keys[0]]       = true;
+		settings.KeyRemapTarget[keys[0]] = 50;
+
+		Input::Router router;
+		Output        output;
+		Player        player{};
+		router.Apply(settings, tps);
+
+		int64_t          now            = start;
+		int64_t          fpsUntil       = now;
+		int64_t          frameTicks     = tps / 60;
+		int64_t          conditionUntil = now;
+		int64_t          messageNow     = now;
+		bool             conditions     = false;
+		bool             cursor         = false;
+		bool             uiState        = false;   /* E.g. the map is open, nothing is evaluated and nothing redirected. */
+		bool             inhibited      = false;
+		bool             wantsMouse     = false;
+		ERedirectContext context        = ERedirectContext_Default;
+		int              pending        = 0;       /* Toggles sent to the game that it has not applied yet. */
+		int              pendingFrames  = 0;
+		int64_t          held           = 0;
+
+		/* Handles a message like WndProc, timed and checked for allocations. */
+		auto send = [&](uint32_t aMsg, uint64_t aWParam, int64_t aLParam)
+		{
+			Input::Message message{ aMsg, aWParam, aLParam, messageNow, player.Alt, cursor, inhibited };
+
+			uint64_t allocations = Profiler::Allocations();
+			auto     begin       = std::chrono::steady_clock::now();
+			router.Process(message, output);
+			uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+			hour.Allocations += Profiler::Allocations() - allocations;
+			hour.Messages.Add(ns);
+		};
+
+		/* The button's up, unless it is missed e.g. when released outside the window. */
+		auto buttonUp = [&](uint64_t aButton, bool aMissed)
+		{
+			player.Buttons &= ~aButton;
+			if (aMissed)
+			{
+				player.Synced = false;
+				return;
+			}
+			send(aButton == Input::EMouseKey_LButton ? Input::EMessage_LButtonUp : Input::EMessage_RButtonUp, player.Buttons | player.Modifiers, rng.Range(0, 0xFFFFFFF));
+		};
+
+		auto buttonDown = [&](uint64_t aButton)
+		{
+			player.Buttons |= aButton;
+			bool doubleClick = rng.OneIn(10);
+			send(aButton == Input::EMouseKey_LButton
+				? (doubleClick ? Input::EMessage_LButtonDblClk : Input::EMessage_LButtonDown)
+				: (doubleClick ? Input::EMessage_RButtonDblClk : Input::EMessage_RButtonDown),
+				player.Buttons | player.Modifiers, rng.Range(0, 0xFFFFFFF));
+		};
+
+		for (int h = 0; h < aHours; h++)
+		{
+			hour = {};
+			rules.OverrideExpiry = h % 3;
+			int64_t hourEnd = start + hourTicks * (h + 1);
+
+			while (now < hourEnd)
+			{
+				/* Frame rate changes every now and then, each frame jitters by 10%. */
+				if (now >= fpsUntil)
+				{
+					frameTicks = tps / rng.Range(30, 240);
+					fpsUntil   = now + tps * rng.Range(10, 120);
+				}
+				int64_t last = now;
+				now += frameTicks * rng.Range(90, 110) / 100;
+
+				if (now >= conditionUntil)
+				{
+					conditions     = !conditions;
+					conditionUntil = now + rng.Range(tps / 10, tps * 15);
+					uiState        = rng.OneIn(20);
+					inhibited      = rng.OneIn(20);
+					wantsMouse     = rng.OneIn(10);
+					context        = (ERedirectContext)rng.Range(0, ERedirectContext_COUNT - 1);
+
+					/* The player changes the settings now and then. */
+					if (rng.OneIn(50))
+					{
+						settings.Redirect[rng.Range(0, 1)] = rng.OneIn(2);
+						settings.Chord     = rng.OneIn(2);
+						settings.RemapKeys = rng.OneIn(2);
+						router.Apply(settings, tps);
+					}
+				}
+
+				/* The game applies InvokeAsync toggles a few frames late. */
+				if (pending && --pendingFrames <= 0)
+				{
+					cursor = !cursor;
+					pending--;
+					pendingFrames = (int)rng.Range(1, 3);
+				}
+
+				uint64_t event = rng.Next() % 100000;
+				if (event < 3)
+				{
+					/* The player presses their action cam key. */
+					state.Override          = Activation::OverrideForPress(state.Override, cursor ? EOverride_ManualOff : EOverride_ManualOn, rules.OverrideExpiry);
+					state.OverrideCondition = conditions && !inhibited;
+					state.OverrideSince     = now;
+					cursor                  = !cursor;
+					hour.Overrides++;
+				}
+				else if (event < 5)
+				{
+					/* The player opens a UI panel, the addon drops action cam for it. */
+					state.WasActive = false;
+					cursor          = false;
+				}
+				else if (event < 7 && cursor)
+				{
+					/* The game leaves action cam on its own, e.g. for a vista, the addon only sees the cursor. */
+					cursor = false;
+					hour.Drops++;
+				}
+
+				/* Input between the last frame and this one, about a click a second and every fourth a chord. */
+				messageNow = messageNow > last ? messageNow : last;
+				if (rng.OneIn(60))
+				{
+					uint64_t button = rng.OneIn(2) ? Input::EMouseKey_RButton : Input::EMouseKey_LButton;
+					uint64_t other  = button ^ (Input::EMouseKey_LButton | Input::EMouseKey_RButton);
+					messageNow += rng.Range(0, frameTicks);
+
+					if (player.Buttons & button)
+					{
+						buttonUp(button, rng.OneIn(50));
+					}
+					else
+					{
+						player.Modifiers = rng.OneIn(4) ? (uint64_t)Input::EMouseKey_Shift : rng.OneIn(8) ? (uint64_t)Input::EMouseKey_Control : 0;
+						player.Alt       = rng.OneIn(16);
+						buttonDown(button);
+
+						if (!(player.Buttons & other) && rng.OneIn(4))
+						{
+							messageNow += rng.Range(0, chordWindow * 2);
+							buttonDown(other);
+						}
+					}
+				}
+
+				/* Moves carry the buttons held, which ends binds whose up was missed. */
+				if (rng.OneIn(2))
+				{
+					messageNow += rng.Range(0, frameTicks / 4);
+					send(Input::EMessage_MouseMove, player.Buttons | player.Modifiers, rng.Range(0, 0xFFFFFFF));
+					player.Synced = true;
+				}
+
+				for (int key = 0; key < 2; key++)
+				{
+					if (rng.OneIn(120))
+					{
+						player.KeyDown[key] = !player.KeyDown[key];
+						send(player.KeyDown[key] ? Input::EMessage_KeyDown : Input::EMessage_KeyUp, keys[key], 0);
+					}
+					else if (player.KeyDown[key] && rng.OneIn(8))
+					{
+						/* Autorepeat, bit 30 is the previous key state. */
+						send(Input::EMessage_KeyDown, keys[key], 1 << 30);
+					}
+				}
+
+				if (!player.Buttons && player.Synced && !player.KeyDown[0] && !player.KeyDown[1] && output.Held)
+				{
+					hour.StuckBinds++;
+				}
+
+				/* What PreRender publishes for the next messages. */
+				bool dragging  = router.IsDragging();
+				bool actionCam = cursor && !dragging;
+				router.SetActionCam(actionCam);
+				router.SetWantsMouse(wantsMouse);
+				if (uiState || inhibited)
+				{
+					router.Suspend();
+				}
+				else
+				{
+					router.SetContext(context);
+				}
+
+				/* Not evaluated in UI states or while dragging, as in PreRender. */
+				bool evaluated = !uiState && !dragging;
+				if (evaluated)
+				{
+					Activation::Frame frame{ actionCam, conditions && !inhibited, now };
+
+					uint64_t allocations = Profiler::Allocations();
+					auto     begin       = std::chrono::steady_clock::now();
+					Activation::EStep step = Activation::Step(state, frame, rules);
+					uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+					hour.Allocations += Profiler::Allocations() - allocations;
+					hour.Steps.Add(ns);
+
+					if (step == Activation::EStep_Toggle)
+					{
+						hour.Toggles++;
+						if (pending++ == 0)
+						{
+							pendingFrames = (int)rng.Range(1, 3);
+						}
+					}
+					else if (step == Activation::EStep_Overridden &&
+						rules.OverrideExpiry == EOverrideExpiry_Timeout &&
+						now - state.OverrideSince > rules.OverrideTimeout)
+					{
+						hour.OverrideOverdue = true;
+					}
+				}
+
+				/* Frames that are not evaluated neither count nor end the stretch. */
+				if (state.Override != EOverride_None || pending || !state.WasActive || cursor)
+				{
+					held = 0;
+				}
+				else if (evaluated)
+				{
+					held += now - last;
+					hour.Held = held > hour.Held ? held : hour.Held;
+				}
+			}
+
+			hour.Presses = output.Presses;
+			output.Presses = 0;
+
+			bool stuck = hour.Held > heldLimit;
+			passed &= !hour.Allocations && !hour.OverrideOverdue && !stuck && !hour.StuckBinds;
+
+			snprintf(line, sizeof(line), "hour %d: %llu steps, %llu messages, %llu toggles, %llu overrides, %llu drops, %llu presses, step p50 %llu ns, p99 %llu ns, max %llu ns, message p50 %llu ns, p99 %llu ns, max %llu ns, %llu allocations, longest held %.1f s, %llu stuck binds%s%s\n",
+				h + 1,
+				(unsigned long long)hour.Steps.Calls,
+				(unsigned long long)hour.Messages.Calls,
+				(unsigned long long)hour.Toggles,
+				(unsigned long long)hour.Overrides,
+				(unsigned long long)hour.Drops,
+				(unsigned long long)hour.Presses,
+				(unsigned long long)Percentile(hour.Steps, 0.50),
+				(unsigned long long)Percentile(hour.Steps, 0.99),
+				(unsigned long long)hour.Steps.Max,
+				(unsigned long long)Percentile(hour.Messages, 0.50),
+				(unsigned long long)Percentile(hour.Messages, 0.99),
+				(unsigned long long)hour.Messages.Max,
+				(unsigned long long)hour.Allocations,
+				hour.Held / (double)tps,
+				(unsigned long long)hour.StuckBinds,
+				hour.OverrideOverdue ? ", override overdue" : "",
+				stuck ? ", stuck" : "");
+			aOut += line;
+		}
+
+		/* The player lets go of everything, nothing may stay held. */
+		messageNow += frameTicks;
+		buttonUp(Input::EMouseKey_LButton, false);
+		buttonUp(Input::EMouseKey_RButton, false);
+		for (int key = 0; key < 2; key++)
+		{
+			send(Input::EMessage_KeyUp, keys[key], 0);
+		}
+
+		if (output.Held != 0 || router.Held() != 0)
+		{
+			snprintf(line, sizeof(line), "%lld binds held at the end\n", (long long)output.Held);
+			aOut += line;
+			passed = false;
+		}
+
+		aOut += passed ? "passed\n" : "FAILED\n";
+		return passed;
+	}
+}
+
+#endif
@@ -0,0 +1,18 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  SoakTests.cpp
+/// Description  :  Runs the soak over a working day of simulated play.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Soak.h"
+#include "Test.h"
+
+TEST(Soak, EightHours)
+{
+	std::string out;
+	bool passed = Soak::Run(8, 0x5EED, out);
+	printf("%s", out.c_str());
+	CHECK(passed);
+}
@@ -0,0 +1,65 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Test.h
+/// Description  :  Minimal test registry and checks for the platform independent parts.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <cstdio>
+#include <vector>
+
+///----------------------------------------------------------------------------------------------------
+/// Test Namespace
+/// 	Tests register themselves per suite, Main.cpp runs the suite named on the command line.
+///----------------------------------------------------------------------------------------------------
+namespace Test
+{
+	typedef void (*TEST_FUNC)();
+
+	struct Case
+	{
+		const char* Suite;
+		const char* Name;
+		TEST_FUNC   Func;
+	};
+
+	inline std::vector<Case>& Cases()
+	{
+		static std::vector<Case> s_Cases;
+		return s_Cases;
+	}
+
+	inline int& Failures()
+	{
+		static int s_Failures = 0;
+		return s_Failures;
+	}
+
+	struct Register
+	{
+		Register(const char* aSuite, const char* aName, TEST_FUNC aFunc)
+		{
+			Cases().push_back(Case{ aSuite, aName, aFunc });
+		}
+	};
+
+	inline void Fail(const char* aFile, int aLine, const char* aExpr)
+	{
+		fprintf(stderr, "%s:%d: check failed: %s\n", aFile, aLine, aExpr);
+		Failures()++;
+	}
+}
+
+#define TEST(suite, name) \
+	static void suite##_##name(); \
+	static Test::Register s_Register_##suite##_##name(#suite, #name, suite##_##name); \
+	static void suite##_##name()
+
+#define CHECK(expr) \
+	do { if (!(expr)) { Test::Fail(__FILE__, __LINE__, #expr); } } while (0)
+
+#endif
@@ -0,0 +1,260 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  TraceTests.cpp
+/// Description  :  Trace encoding and replay tests.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "Trace.h"
+#include "Fakes.h"
+#include "Test.h"
+
+static const Activation::Rules s_Rules    = { EOverrideExpiry_OnConditionChange, 0, 0 };
+static const Input::Settings   s_Settings = {};
+static const uint32_t          s_SuspendUiState = EUiState_MapOpen | EUiState_GameUnfocused | EUiState_TextboxFocused;
+
+static constexpr uint32_t IN_ACTION_CAM = Trace::EFrame_IsGameplay | Trace::EFrame_IsCursorHidden | Trace::EFrame_Evaluated;
+
+static Trace::Frame MakeFrame(uint32_t aFlags)
+{
+	Trace::Frame frame{};
+	frame.Flags = aFlags;
+	return frame;
+}
+
+TEST(Trace, VarintsRoundTrip)
+{
+	const uint64_t values[] = { 0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, 1ull << 35, UINT64_MAX };
+
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, s_Settings, s_SuspendUiState, 0);
+	size_t start = writer.Buffer.size();
+
+	for (uint64_t value : values)
+	{
+		writer.WriteMessage(0, MakeMessage(0, value));
+	}
+
+	size_t pos = start;
+	for (uint64_t value : values)
+	{
+		uint64_t record, delta, msg, wParam, lParam, flags;
+		/* Record kinds are single bytes below 0x80, so they read as varints. */
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, record) && record == Trace::ERecord_Message);
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, delta) && delta == 0);
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, msg) && msg == 0);
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, wParam) && wParam == value);
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, lParam) && lParam == 0);
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, flags) && flags == Trace::EMessageFlag_CursorHidden);
+	}
+
+	CHECK(pos == writer.Buffer.size());
+}
+
+TEST(Trace, SettingsRoundTrip)
+{
+	Input::Settings settings{};
+	settings.Redirect[ERedirectButton_RMB] = true;
+	settings.RedirectOverride[ERedirectContext_Mount][ERedirectButton_RMB] = true;
+	settings.RedirectTarget[ERedirectContext_Mount][ERedirectButton_RMB]   = 300;
+	settings.RedirectModifierOverride[ERedirectButton_LMB][ERedirectModifier_Ctrl | ERedirectModifier_Alt] = true;
+	settings.RedirectModifierTarget[ERedirectButton_LMB][ERedirectModifier_Ctrl | ERedirectModifier_Alt]   = 7;
+	settings.Chord          = true;
+	settings.ChordTarget    = 12;
+	settings.ChordWindowMs  = 80;
+	settings.RemapKeys      = true;
+	settings.KeyRemap[0xFF] = true;
+	settings.KeyRemapTarget[0xFF] = 0;
+	settings.KeyRemap['1']  = true;
+	settings.KeyRemapTarget['1'] = 1000;
+	settings.ExitOnUiKeys   = true;
+	settings.UiKey['I']     = true;
+	settings.ActionCamKey   = 'V';
+
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, settings, s_SuspendUiState, 0);
+
+	/* Skip the eleven varints before the settings. */
+	size_t   pos = 0;
+	uint64_t value;
+	for (int i = 0; i < 11; i++)
+	{
+		CHECK(Trace::ReadVarint(writer.Buffer, pos, value));
+	}
+
+	Input::Settings read{};
+	CHECK(Trace::ReadSettings(writer.Buffer, pos, read));
+	CHECK(pos == writer.Buffer.size());
+	CHECK(memcmp(read.Redirect, settings.Redirect, sizeof(settings.Redirect)) == 0);
+	CHECK(memcmp(read.RedirectOverride, settings.RedirectOverride, sizeof(settings.RedirectOverride)) == 0);
+	CHECK(memcmp(read.RedirectTarget, settings.RedirectTarget, sizeof(settings.RedirectTarget)) == 0);
+	CHECK(memcmp(read.RedirectModifierOverride, settings.RedirectModifierOverride, sizeof(settings.RedirectModifierOverride)) == 0);
+	CHECK(memcmp(read.RedirectModifierTarget, settings.RedirectModifierTarget, sizeof(settings.RedirectModifierTarget)) == 0);
+	CHECK(read.Chord == settings.Chord && read.ChordTarget == settings.ChordTarget && read.ChordWindowMs == settings.ChordWindowMs);
+	CHECK(read.RemapKeys == settings.RemapKeys);
+	CHECK(memcmp(read.KeyRemap, settings.KeyRemap, sizeof(settings.KeyRemap)) == 0);
+	CHECK(memcmp(read.KeyRemapTarget, settings.KeyRemapTarget, sizeof(settings.KeyRemapTarget)) == 0);
+	CHECK(read.ExitOnUiKeys == settings.ExitOnUiKeys);
+	CHECK(memcmp(read.UiKey, settings.UiKey, sizeof(settings.UiKey)) == 0);
+	CHECK(read.ActionCamKey == settings.ActionCamKey && read.ActionCamDisableKey == settings.ActionCamDisableKey);
+}
+
+TEST(Trace, ReplayDerivesToggles)
+{
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, s_Settings, s_SuspendUiState, 5000);
+
+	writer.WriteFrame(5010, MakeFrame(Trace::EFrame_IsGameplay | Trace::EFrame_Evaluated | Trace::EFrame_ShouldActivate));
+	writer.WriteEvent(5010, Trace::ERecord_Toggle);
+	writer.WriteFrame(5020, MakeFrame(IN_ACTION_CAM | Trace::EFrame_ShouldActivate));
+	writer.WriteEvent(5030, Trace::ERecord_Toggle);
+	writer.WriteFrame(5030, MakeFrame(IN_ACTION_CAM));
+
+	std::string replayed;
+	std::string recorded;
+	CHECK(Trace::Replay(writer.Buffer, replayed, &recorded));
+	CHECK(replayed == "10.000 toggle\n30.000 toggle\n");
+	CHECK(recorded == replayed);
+}
+
+TEST(Trace, ReplayRoutesMessages)
+{
+	Input::Settings settings{};
+	settings.Redirect[ERedirectButton_LMB] = true;
+	settings.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = 21;
+	settings.RedirectOverride[ERedirectContext_Combat][ERedirectButton_LMB] = true;
+	settings.RedirectTarget[ERedirectContext_Combat][ERedirectButton_LMB]   = 22;
+
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, settings, s_SuspendUiState, 0);
+
+	Trace::Frame frame = MakeFrame(IN_ACTION_CAM);
+	frame.Context = ERedirectContext_Combat;
+	writer.WriteFrame(1, frame);
+	writer.WriteMessage(2, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton, 2));
+	writer.WriteMessage(3, MakeMessage(Input::EMessage_LButtonUp, 0, 3));
+
+	/* Suspended, e.g. inhibited, the click goes to the game. */
+	frame.Context = ERedirectContext_COUNT;
+	writer.WriteFrame(4, frame);
+	writer.WriteMessage(5, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton, 5));
+	writer.WriteMessage(6, MakeMessage(Input::EMessage_LButtonUp, 0, 6));
+
+	std::string replayed;
+	CHECK(Trace::Replay(writer.Buffer, replayed));
+	CHECK(replayed == "2.000 press 22\n3.000 release 22\n");
+}
+
+TEST(Trace, ReplayDerivesDrags)
+{
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, s_Settings, s_SuspendUiState, 0);
+
+	/* A camera drag hides the cursor, which must not be taken for action cam. */
+	Input::Message down = MakeMessage(Input::EMessage_RButtonDown, Input::EMouseKey_RButton, 1);
+	down.CursorHidden = false;
+	writer.WriteMessage(1, down);
+	writer.WriteFrame(2, MakeFrame(IN_ACTION_CAM | Trace::EFrame_ShouldActivate));
+	writer.WriteMessage(3, MakeMessage(Input::EMessage_RButtonUp, 0, 3));
+	writer.WriteFrame(4, MakeFrame(Trace::EFrame_IsGameplay | Trace::EFrame_Evaluated | Trace::EFrame_ShouldActivate));
+
+	std::string replayed;
+	CHECK(Trace::Replay(writer.Buffer, replayed));
+	CHECK(replayed == "4.000 toggle\n");
+}
+
+TEST(Trace, ReplayKeepsTheOverrideAge)
+{
+	const Activation::Rules rules = { EOverrideExpiry_Timeout, 100, 0 };
+
+	Activation::State state{};
+	state.Override      = EOverride_ManualOff;
+	state.OverrideSince = 910;
+
+	Trace::Writer writer;
+	writer.Begin(1000, rules, state, s_Settings, s_SuspendUiState, 1000);
+
+	const uint32_t off = Trace::EFrame_IsGameplay | Trace::EFrame_Evaluated | Trace::EFrame_ShouldActivate;
+	writer.WriteFrame(1010, MakeFrame(off));
+	writer.WriteFrame(1011, MakeFrame(off));
+
+	std::string replayed;
+	CHECK(Trace::Replay(writer.Buffer, replayed));
+	CHECK(replayed == "11.000 toggle\n");
+}
+
+TEST(Trace, ReplaySuspendsWhileTyping)
+{
+	Input::Settings settings{};
+	settings.Redirect[ERedirectButton_LMB] = true;
+	settings.RedirectTarget[ERedirectContext_Default][ERedirectButton_LMB] = 21;
+
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, settings, s_SuspendUiState, 0);
+
+	/* The player starts chatting while moving, action cam must not fight the chat box. */
+	Trace::Frame frame = MakeFrame(Trace::EFrame_IsGameplay | Trace::EFrame_ShouldActivate);
+	frame.UiState = EUiState_TextboxFocused;
+	writer.WriteFrame(1, frame);
+
+	/* Already in action cam, clicks go to the game while typing. */
+	frame.Flags = IN_ACTION_CAM | Trace::EFrame_ShouldActivate;
+	writer.WriteFrame(2, frame);
+	writer.WriteMessage(3, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton, 3));
+	writer.WriteMessage(4, MakeMessage(Input::EMessage_LButtonUp, 0, 4));
+
+	/* The chat box lost focus. */
+	frame.Flags   = Trace::EFrame_IsGameplay | Trace::EFrame_ShouldActivate;
+	frame.UiState = EUiState_None;
+	writer.WriteFrame(5, frame);
+	frame.Flags = IN_ACTION_CAM | Trace::EFrame_ShouldActivate;
+	writer.WriteFrame(6, frame);
+	writer.WriteMessage(7, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton, 7));
+	writer.WriteMessage(8, MakeMessage(Input::EMessage_LButtonUp, 0, 8));
+
+	std::string replayed;
+	CHECK(Trace::Replay(writer.Buffer, replayed));
+	CHECK(replayed == "5.000 toggle\n7.000 press 21\n8.000 release 21\n");
+}
+
+TEST(Trace, ReplayOnlySuspendsForSelectedUiStates)
+{
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, s_Settings, EUiState_MapOpen, 0);
+
+	/* Typing was not selected to suspend, and competitive modes never were. */
+	Trace::Frame frame = MakeFrame(Trace::EFrame_IsGameplay | Trace::EFrame_ShouldActivate);
+	frame.UiState = EUiState_TextboxFocused | EUiState_Competitive;
+	writer.WriteFrame(1, frame);
+
+	frame.Flags   = IN_ACTION_CAM;
+	frame.UiState = EUiState_MapOpen;
+	writer.WriteFrame(2, frame);
+
+	std::string replayed;
+	CHECK(Trace::Replay(writer.Buffer, replayed));
+	CHECK(replayed == "1.000 toggle\n");
+}
+
+TEST(Trace, RejectsMalformedTraces)
+{
+	Trace::Writer writer;
+	writer.Begin(1000, s_Rules, Activation::State{}, s_Settings, s_SuspendUiState, 0);
+	writer.WriteMessage(10, MakeMessage(Input::EMessage_LButtonDown, Input::EMouseKey_LButton));
+
+	std::string out;
+	std::vector<uint8_t> truncated(writer.Buffer.begin(), writer.Buffer.end() - 1);
+	CHECK(!Trace::Replay(truncated, out));
+
+	std::vector<uint8_t> unknown = writer.Buffer;
+	unknown.push_back(0x7F);
+	unknown.push_back(0);
+	CHECK(!Trace::Replay(unknown, out));
+
+	std::vector<uint8_t> magic = writer.Buffer;
+	magic[0] ^= 1;
+	CHECK(!Trace::Replay(magic, out));
+}
@@ -0,0 +1,449 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Tsan.cpp
+/// Description  :  Runs the message, render and addon threads against each other under ThreadSanitizer.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Core.h"
+#include "Input.h"
+#include "Shared.h"
+#include "Trace.h"
+
+static constexpr int64_t TPS        = 1000000000; /* Ticks are nanoseconds. */
+static constexpr int     KEY_REMAP  = 'Q';
+static constexpr int     KEY_UI     = 'I';
+static constexpr int     KEY_CAM    = 'V';
+static constexpr int     KEY_ESCAPE = 0x1B;
+
+///----------------------------------------------------------------------------------------------------
+/// CountingGame:
+/// 	Stands in for the game binds, presses minus releases must end at zero. Toggles are applied by
+/// 	the render thread on a later frame, async ones also come back through the message thread as
+/// 	the action cam key, as InvokeAsync does in game.
+///----------------------------------------------------------------------------------------------------
+class CountingGame : public Core::GameProvider
+{
+public:
+	void Press(Input::Bind) override
+	{
+		Held.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Release(Input::Bind) override
+	{
+		Held.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void ButtonUp(uint32_t, uint64_t, int64_t) override
+	{
+	}
+
+	void ToggleActionCam(bool aImmediate) override
+	{
+		Pending.fetch_add(1, std::memory_order_relaxed);
+		if (!aImmediate)
+		{
+			Echoes.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	std::atomic<int64_t>  Held    = 0;
+	std::atomic<uint32_t> Pending = 0;
+	std::atomic<uint32_t> Echoes  = 0;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// SharedCursor:
+/// 	Hidden is set by the render thread, both threads may move it.
+///----------------------------------------------------------------------------------------------------
+class SharedCursor : public Core::CursorProvider
+{
+public:
+	bool IsHidden() override
+	{
+		return Hidden.load(std::memory_order_relaxed);
+	}
+
+	void GetPosition(int32_t& aX, int32_t& aY) override
+	{
+		aX = X.load(std::memory_order_relaxed);
+		aY = Y.load(std::memory_order_relaxed);
+	}
+
+	void SetPosition(int32_t aX, int32_t aY) override
+	{
+		X.store(aX, std::memory_order_relaxed);
+		Y.store(aY, std::memory_order_relaxed);
+	}
+
+	std::atomic<bool>    Hidden = false;
+	std::atomic<int32_t> X      = 0;
+	std::atomic<int32_t> Y      = 0;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FixedWindow:
+/// 	Queried on start and by the message thread after a resize event.
+///----------------------------------------------------------------------------------------------------
+class FixedWindow : public Core::WindowProvider
+{
+public:
+	Geometry::ClientRect QueryClientRect() override
+	{
+		return Geometry::ClientRect{ 0, 0, 1920, 1080 };
+	}
+};
+
+///----------------------------------------------------------------------------------------------------
+/// RenderLink:
+/// 	Data is written by the render thread before each frame, it reads it within the frame.
+///----------------------------------------------------------------------------------------------------
+class RenderLink : public Core::LinkProvider
+{
+public:
+	void Read(Core::LinkData& aData) override
+	{
+		aData = Data;
+	}
+
+	bool IsCameraMoving() override
+	{
+		return CameraMoving.load(std::memory_order_relaxed);
+	}
+
+	Core::LinkData    Data         = {};
+	std::atomic<bool> CameraMoving = false;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// SteadyClock:
+/// 	Nanoseconds since an arbitrary epoch.
+///----------------------------------------------------------------------------------------------------
+class SteadyClock : public Core::ClockProvider
+{
+public:
+	int64_t Now() override
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	int64_t TicksPerSecond() override
+	{
+		return TPS;
+	}
+};
+
+static std::mutex                        s_Mutex; /* For settings, as in Addon.cpp. */
+static Core::Config                      s_Config;
+
+static CountingGame                      s_Game;
+static SharedCursor                      s_Cursor;
+static FixedWindow                       s_Window;
+static RenderLink                        s_Link;
+static SteadyClock                       s_Clock;
+static Core::Handler                     s_Handler(s_Game, s_Cursor, s_Window, s_Link, s_Clock);
+
+static MouseLookHandler::SharedState     s_SharedState    = {};
+static MouseLookHandler::InhibitChannel  s_InhibitChannel = {};
+
+static std::atomic<bool>                 s_Stop = false;
+static std::atomic<uint64_t>             s_InconsistentReads = 0;
+
+///----------------------------------------------------------------------------------------------------
+/// MessageThread:
+/// 	WndProc: random keys, clicks, moves and window messages with consistent button state.
+///----------------------------------------------------------------------------------------------------
+static void MessageThread(uint32_t aSeed)
+{
+	std::minstd_rand rng(aSeed);
+	uint64_t         buttons = 0;
+	bool             keyDown[256] = {};
+	const uint32_t   keys[] = { KEY_REMAP, KEY_UI, KEY_CAM, KEY_ESCAPE, 'W' };
+
+	while (!s_Stop.load(std::memory_order_relaxed))
+	{
+		Input::Message message{};
+		message.Alt = rng() % 8 == 0;
+
+		/* The addon's own async toggles arrive as the action cam key. */
+		uint32_t echoes = s_Game.Echoes.load(std::memory_order_relaxed);
+		if (echoes && s_Game.Echoes.compare_exchange_strong(echoes, echoes - 1, std::memory_order_relaxed))
+		{
+			message.Msg    = Input::EMessage_KeyDown;
+			message.WParam = KEY_CAM;
+			s_Handler.Process(message);
+
+			message.Msg    = Input::EMessage_KeyUp;
+			message.LParam = (int64_t)(3u << 30);
+			s_Handler.Process(message);
+			continue;
+		}
+
+		uint32_t pick = rng() % 10;
+		if (pick < 3)
+		{
+			uint32_t vk = keys[rng() % (sizeof(keys) / sizeof(keys[0]))];
+			message.WParam = vk;
+			if (keyDown[vk])
+			{
+				message.Msg    = Input::EMessage_KeyUp;
+				message.LParam = (int64_t)(3u << 30);
+			}
+			else
+			{
+				message.Msg    = Input::EMessage_KeyDown;
+			}
+			keyDown[vk] = !keyDown[vk];
+		}
+		else if (pick < 7)
+		{
+			uint64_t button = rng() % 2 ? Input::EMouseKey_RButton : Input::EMouseKey_LButton;
+			bool     up     = buttons & button;
+			buttons ^= button;
+
+			message.Msg    = button == Input::EMouseKey_LButton
+			               ? (up ? Input::EMessage_LButtonUp : Input::EMessage_LButtonDown)
+			               : (up ? Input::EMessage_RButtonUp : Input::EMessage_RButtonDown);
+			message.WParam = buttons | (rng() % 4 == 0 ? (uint64_t)Input::EMouseKey_Shift : 0);
+			message.LParam = (int64_t)(rng() & 0xFFFFFFFF);
+		}
+		else if (pick < 8)
+		{
+			message.Msg    = Input::EMessage_MouseMove;
+			message.WParam = buttons;
+		}
+		else if (pick < 9)
+		{
+			message.Msg    = Input::EMessage_SetCursor;
+		}
+		else
+		{
+			message.Msg    = rng() % 2 ? Input::EMessage_Move : Input::EMessage_Size;
+			message.LParam = (int64_t)(rng() & 0x0FFF0FFF);
+		}
+
+		s_Handler.Process(message);
+	}
+}
+
+///----------------------------------------------------------------------------------------------------
+/// RenderThread:
+/// 	PreRender and RenderOptions: the game applies the toggles, the link data changes now and then,
+/// 	the options edit and apply settings and start and stop recordings.
+///----------------------------------------------------------------------------------------------------
+static void RenderThread(uint32_t aSeed)
+{
+	std::minstd_rand rng(aSeed);
+	bool             actionCam = false;
+	bool             dragged   = false;
+
+	while (!s_Stop.load(std::memory_order_relaxed))
+	{
+		/* The game applies toggles when it gets to them, and drops action cam on its own now and then. */
+		uint32_t pending = s_Game.Pending.exchange(0, std::memory_order_relaxed);
+		if ((pending & 1) || rng() % 256 == 0)
+		{
+			actionCam = !actionCam;
+		}
+		if (rng() % 64 == 0)
+		{
+			dragged = !dragged;
+		}
+		s_Cursor.Hidden.store(actionCam || dragged, std::memory_order_relaxed);
+		s_Link.CameraMoving.store(rng() % 4 == 0, std::memory_order_relaxed);
+
+		Core::LinkData& data = s_Link.Data;
+		if (rng() % 16 == 0)
+		{
+			data.IsGameplay       = rng() % 16 != 0;
+			data.IsMoving         = rng() % 2;
+			data.UiState          = rng() % 8 == 0 ? (uint32_t)(1u << (rng() % 7)) : (uint32_t)EUiState_None;
+			data.MountIndex       = rng() % 4 == 0 ? 1 + rng() % 10 : 0;
+			data.CameraDistanceSq = (float)(rng() % 64);
+		}
+
+		s_Handler.Frame(rng() % 8 == 0, rng() % 16 == 0);
+
+		if (rng() % 8 == 0)
+		{
+			const std::lock_guard<std::mutex> lock(s_Mutex);
+			Core::Config& config = s_Config;
+
+			config.ResetToCenter      = rng() % 2;
+			config.RestoreCursor      = !config.ResetToCenter && rng() % 2;
+			config.EnableInCombat     = rng() % 2;
+			config.EnableOnMount      = rng() % 2;
+			config.EnableWhenZoomedIn = rng() % 2;
+			config.RedirectLMB        = rng() % 2;
+			config.RedirectRMB        = rng() % 2;
+			config.RedirectOverride[rng() % ERedirectContext_COUNT][rng() % ERedirectButton_COUNT] = rng() % 2;
+			config.RedirectTarget[rng() % ERedirectContext_COUNT][rng() % ERedirectButton_COUNT]   = rng() % 100;
+			config.RedirectModifierOverride[rng() % ERedirectButton_COUNT][rng() % ERedirectModifier_COUNT] = rng() % 2;
+			config.RedirectModifierTarget[rng() % ERedirectButton_COUNT][rng() % ERedirectModifier_COUNT]   = rng() % 100;
+			config.Chord              = rng() % 2;
+			config.ChordTarget        = rng() % 100;
+			config.ChordWindowMs      = (int)(rng() % 100);
+			config.RemapKeys          = rng() % 2;
+			config.KeyRemap[KEY_REMAP]       = true;
+			config.KeyRemapTarget[KEY_REMAP] = rng() % 100;
+			config.ExitOnUiKeys       = rng() % 2;
+			config.UiKey[KEY_UI]      = true;
+			config.ActionCamKey       = KEY_CAM;
+			config.OverrideExpiry     = (int)(rng() % 3);
+			config.OverrideTimeoutSec = 1;
+
+			s_Handler.Apply(config);
+		}
+
+		/* Start and Stop Recording, in the lock order of Addon.cpp. */
+		if (rng() % 128 == 0)
+		{
+			if (!s_Handler.IsRecording())
+			{
+				const std::lock_guard<std::mutex> lock(s_Mutex);
+				s_Handler.StartRecording();
+			}
+			else
+			{
+				std::string replayed;
+				if (!Trace::Replay(s_Handler.StopRecording(), replayed))
+				{
+					fprintf(stderr, "a trace recorded under load did not replay\n");
+					exit(1);
+				}
+			}
+		}
+	}
+}
+
+///----------------------------------------------------------------------------------------------------
+/// EventThread:
+/// 	Nexus: the hold-to-suspend bind and the resize and identity events.
+///----------------------------------------------------------------------------------------------------
+static void EventThread(uint32_t aSeed)
+{
+	std::minstd_rand rng(aSeed);
+
+	while (!s_Stop.load(std::memory_order_relaxed))
+	{
+		switch (rng() % 64)
+		{
+			case 0:  s_Handler.SetHoldSuspended(true);  break;
+			case 1:  s_Handler.SetHoldSuspended(false); break;
+			case 2:  s_Handler.InvalidateClientRect();  break;
+			case 3:  s_Handler.ResetIdentity();         break;
+		}
+
+		std::this_thread::yield();
+	}
+
+	s_Handler.SetHoldSuspended(false);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// AddonThread:
+/// 	Another addon: reads the shared state and sets its inhibit bit now and then.
+///----------------------------------------------------------------------------------------------------
+static void AddonThread(uint32_t aSeed)
+{
+	std::minstd_rand rng(aSeed);
+	int              bit = MouseLookHandler::ClaimInhibit(&s_InhibitChannel);
+
+	/* A frame outside gameplay or dragging never reports action cam, and one outside gameplay keeps the
+	 * default profile. A torn read may mix two frames. */
+	constexpr uint32_t noActionCam = MouseLookHandler::ESuspend_NotGameplay | MouseLookHandler::ESuspend_Dragging;
+
+	while (!s_Stop.load(std::memory_order_relaxed))
+	{
+		MouseLookHandler::State state{};
+		if (MouseLookHandler::Read(&s_SharedState, &state) &&
+			(((state.Suspend & noActionCam) && state.IsActionCam) ||
+			 ((state.Suspend & MouseLookHandler::ESuspend_NotGameplay) && state.Profile != MouseLookHandler::EProfile_Default)))
+		{
+			s_InconsistentReads.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (bit >= 0 && rng() % 1024 == 0)
+		{
+			MouseLookHandler::SetInhibit(&s_InhibitChannel, bit, rng() % 2);
+		}
+	}
+
+	if (bit >= 0)
+	{
+		MouseLookHandler::ReleaseInhibit(&s_InhibitChannel, bit);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int milliseconds = argc > 1 ? atoi(argv[1]) : 2000;
+
+	s_SharedState.Version.store(MLH_STATE_VERSION, std::memory_order_release);
+	s_Link.Data.IsGameplay = true;
+
+	s_Handler.Start(&s_SharedState, &s_InhibitChannel);
+	{
+		const std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Handler.Apply(s_Config);
+	}
+
+	std::vector<std::thread> threads;
+	threads.emplace_back(MessageThread, 1u);
+	threads.emplace_back(RenderThread, 2u);
+	threads.emplace_back(EventThread, 3u);
+	threads.emplace_back(AddonThread, 4u);
+	threads.emplace_back(AddonThread, 5u);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+	s_Stop.store(true);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	/* As on unload, then nothing may be left held. */
+	s_Handler.Stop();
+
+	bool passed = true;
+
+	if (s_InconsistentReads.load())
+	{
+		fprintf(stderr, "%llu inconsistent reads of the shared state\n", (unsigned long long)s_InconsistentReads.load());
+		passed = false;
+	}
+
+	if (s_Game.Held.load() != 0 || s_Handler.GetRouter().Held() != 0)
+	{
+		fprintf(stderr, "%lld binds left held\n", (long long)s_Game.Held.load());
+		passed = false;
+	}
+
+	if (s_InhibitChannel.Claimed.load() != 0 || s_InhibitChannel.Inhibit.load() != 0)
+	{
+		fprintf(stderr, "inhibit bits left set\n");
+		passed = false;
+	}
+
+	MouseLookHandler::State state{};
+	if (!MouseLookHandler::Read(&s_SharedState, &state) || state.Suspend != MouseLookHandler::ESuspend_Unloaded || state.IsActionCam)
+	{
+		fprintf(stderr, "the unloaded state was not published\n");
+		passed = false;
+	}
+
+	printf("%s\n", passed ? "passed" : "FAILED");
+	return passed ? 0 : 1;
+}